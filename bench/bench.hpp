@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// минимальный каркас бенчмарков: регистрация кейсов и замер времени
+namespace bench {
+
+struct Result {
+    double seconds = 0; // лучшее время одного прогона
+    double items   = 0; // сколько элементов обработано за прогон
+    double bytes   = 0; // сколько байт прочитано за прогон (для GB/s), 0 если не важно
+    bool   skipped = false; // кейс не поддерживается на этой машине
+};
+
+using CaseFn = Result (*)();
+
+struct Case {
+    std::string name;
+    CaseFn      fn;
+};
+
+inline std::vector<Case>& registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+struct Registrar {
+    Registrar(const char* name, CaseFn fn) { registry().push_back({name, fn}); }
+};
+
+// множитель объёма работы: --quick уменьшает его для смоук-прогонов
+inline double& scale() {
+    static double s = 1.0;
+    return s;
+}
+
+inline std::size_t scaled(std::size_t n) {
+    auto r = static_cast<std::size_t>(static_cast<double>(n) * scale());
+    return r ? r : 1;
+}
+
+template <class T>
+inline void do_not_optimize(const T& v) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(v) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &v;
+#endif
+}
+
+inline void clobber() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+// прогоняет body reps раз и берёт лучшее время
+template <class Body>
+Result measure(double items, Body&& body, int reps = 5) {
+    using clock = std::chrono::steady_clock;
+    double best = 1e300;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = clock::now();
+        body();
+        auto t1 = clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    Result res;
+    res.seconds = best;
+    res.items = items;
+    return res;
+}
+
+} // namespace bench
+
+#define BENCH_CAT_(a, b) a##b
+#define BENCH_CAT(a, b) BENCH_CAT_(a, b)
+#define BENCH_CASE(name, ...) \
+    static ::bench::Registrar BENCH_CAT(bench_reg_, __LINE__)(name, __VA_ARGS__)
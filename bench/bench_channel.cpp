@@ -0,0 +1,121 @@
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "alloc/async_channel.hpp"
+#include "bench.hpp"
+
+#if ALLOC_HAVE_COROUTINES
+
+namespace {
+
+constexpr std::size_t kMessages = 1u << 18;
+constexpr std::size_t kCapacity = 64;
+
+// статический пул допустим: все каналы этого типа - в одном потоке
+using PoolChannel = Channel<std::uint64_t, StaticPoolAllocator<std::uint64_t, kCapacity + 1>>;
+
+AsyncTask produce(PoolChannel& ch, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) co_await ch.push(i);
+    ch.close();
+}
+
+AsyncTask consume(PoolChannel& ch, std::uint64_t& sum) {
+    while (auto v = co_await ch.pop()) sum += *v;
+}
+
+// производитель и потребитель - корутины в одном потоке, без блокировок потоков;
+// с channel/mutex_condvar_2threads сравнивать как цену передачи, а не межпоточный обмен
+bench::Result coroutine_channel() {
+    const std::size_t n = bench::scaled(kMessages);
+    return bench::measure(static_cast<double>(n), [&] {
+        PoolChannel ch(kCapacity);
+        std::uint64_t sum = 0;
+        AsyncTask c = consume(ch, sum);
+        AsyncTask p = produce(ch, n);
+        bench::do_not_optimize(sum);
+    });
+}
+
+// то же через очередь под mutex + condition_variable и два потока
+bench::Result condvar_queue() {
+    const std::size_t n = bench::scaled(kMessages);
+    return bench::measure(static_cast<double>(n), [&] {
+        std::mutex m;
+        std::condition_variable not_empty, not_full;
+        std::deque<std::uint64_t> q;
+        bool done = false;
+        std::uint64_t sum = 0;
+        std::thread consumer([&] {
+            for (;;) {
+                std::unique_lock<std::mutex> lock(m);
+                not_empty.wait(lock, [&] { return !q.empty() || done; });
+                if (q.empty()) return;
+                sum += q.front();
+                q.pop_front();
+                lock.unlock();
+                not_full.notify_one();
+            }
+        });
+        for (std::size_t i = 0; i < n; ++i) {
+            std::unique_lock<std::mutex> lock(m);
+            not_full.wait(lock, [&] { return q.size() < kCapacity; });
+            q.push_back(i);
+            lock.unlock();
+            not_empty.notify_one();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m);
+            done = true;
+        }
+        not_empty.notify_one();
+        consumer.join();
+        bench::do_not_optimize(sum);
+    });
+}
+
+// Ленивая корутина с выбираемой базой promise: создание, один шаг, разрушение.
+template <class Base>
+struct Step {
+    struct promise_type : Base {
+        Step get_return_object() noexcept { return Step{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {}
+    };
+    std::coroutine_handle<promise_type> h;
+    ~Step() { h.destroy(); }
+};
+
+struct HeapPromise {};
+
+template <class Base>
+Step<Base> step(std::uint64_t& acc, std::uint64_t x) {
+    acc += x;
+    co_return;
+}
+
+template <class Base>
+bench::Result coroutine_create_destroy() {
+    const std::size_t n = bench::scaled(kMessages);
+    return bench::measure(static_cast<double>(n), [&] {
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            Step<Base> s = step<Base>(acc, i);
+            s.h.resume();
+        }
+        bench::do_not_optimize(acc);
+    });
+}
+
+BENCH_CASE("channel/coroutine_1thread", coroutine_channel);
+BENCH_CASE("channel/mutex_condvar_2threads", condvar_queue);
+BENCH_CASE("coroutine/create_destroy_pooled", coroutine_create_destroy<PooledPromise>);
+BENCH_CASE("coroutine/create_destroy_heap", coroutine_create_destroy<HeapPromise>);
+
+} // namespace
+
+#endif // ALLOC_HAVE_COROUTINES
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "alloc/alloc.hpp"
+#include "bench.hpp"
+
+namespace {
+
+constexpr std::size_t kMaxKeys = 1u << 16;
+
+using PoolMap  = std::map<int, int, std::less<>,
+                          StaticPoolAllocator<std::pair<const int, int>, kMaxKeys + 2>>;
+using PoolList = SimpleForwardList<int, StaticPoolAllocator<int, kMaxKeys>>;
+// ёмкость не задаётся: растёт кусками или берётся из ALLOC_POOL_PROFILE
+using AdaptiveMap = std::map<int, int, std::less<>, AdaptivePoolAllocator<std::pair<const int, int>>>;
+
+std::vector<int> shuffled_keys(std::size_t n) {
+    std::vector<int> keys(n);
+    std::uint32_t x = 2463534242u;
+    for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<int>(i);
+    for (std::size_t i = n; i > 1; --i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        std::swap(keys[i - 1], keys[x % i]);
+    }
+    return keys;
+}
+
+// вставка, удаление половины и повторная вставка
+template <class Map>
+bench::Result map_churn() {
+    const std::size_t n = bench::scaled(kMaxKeys);
+    const auto keys = shuffled_keys(n);
+    return bench::measure(static_cast<double>(n) * 2.5, [&] {
+        Map m;
+        for (int k : keys) m.emplace(k, k);
+        for (std::size_t i = 0; i < n; i += 2) m.erase(keys[i]);
+        for (std::size_t i = 0; i < n; i += 2) m.emplace(keys[i], keys[i]);
+        bench::do_not_optimize(m.size());
+    });
+}
+
+template <class List>
+bench::Result list_iterate() {
+    const std::size_t n = bench::scaled(kMaxKeys);
+    List l;
+    for (std::size_t i = 0; i < n; ++i) l.push_back(static_cast<int>(i));
+    constexpr int kPasses = 20;
+    return bench::measure(static_cast<double>(n) * kPasses, [&] {
+        for (int p = 0; p < kPasses; ++p) {
+            long long s = 0;
+            for (int x : l) s += x;
+            bench::do_not_optimize(s);
+        }
+    });
+}
+
+template <class List, int IndexShift = -1>
+bench::Result list_build() {
+    const std::size_t n = bench::scaled(kMaxKeys);
+    return bench::measure(static_cast<double>(n), [&] {
+        List l;
+        if (IndexShift >= 0) l.build_index(IndexShift);
+        for (std::size_t i = 0; i < n; ++i) l.push_back(static_cast<int>(i));
+        bench::do_not_optimize(l.size());
+    });
+}
+
+// случайный доступ nth(k) с индексом и без
+template <int IndexShift>
+bench::Result list_nth() {
+    const std::size_t n = bench::scaled(kMaxKeys);
+    PoolList l;
+    if (IndexShift >= 0) l.build_index(IndexShift);
+    for (std::size_t i = 0; i < n; ++i) l.push_back(static_cast<int>(i));
+    const auto keys = shuffled_keys(n);
+    const std::size_t queries = IndexShift >= 0 ? n : std::min<std::size_t>(n, 256);
+    return bench::measure(static_cast<double>(queries), [&] {
+        long long s = 0;
+        for (std::size_t q = 0; q < queries; ++q) s += l.nth(static_cast<std::size_t>(keys[q]));
+        bench::do_not_optimize(s);
+    });
+}
+
+// крупный объект: emplace_back строит его прямо в узле, push_back - через временный
+struct Big {
+    int  id;
+    char payload[252];
+    explicit Big(int i) : id(i) { std::fill(std::begin(payload), std::end(payload), static_cast<char>(i)); }
+};
+
+template <bool Emplace>
+bench::Result list_build_big() {
+    const std::size_t n = bench::scaled(kMaxKeys / 4);
+    using List = SimpleForwardList<Big, StaticPoolAllocator<Big, kMaxKeys / 4>>;
+    return bench::measure(static_cast<double>(n), [&] {
+        List l;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (Emplace) l.emplace_back(static_cast<int>(i));
+            else l.push_back(Big(static_cast<int>(i)));
+        }
+        bench::do_not_optimize(l.size());
+    });
+}
+
+// Много коротких списков: длины берутся из распределения, списки строятся,
+// обходятся и уничтожаются. Dist: 0 - 1..7, 1 - 80% 1..7 / 20% 8..64, 2 - всегда 64.
+template <std::size_t Dist>
+std::vector<std::size_t> list_lengths(std::size_t count) {
+    std::vector<std::size_t> lens(count);
+    std::uint32_t x = 88172645u;
+    for (auto& len : lens) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        if (Dist == 0) len = 1 + x % 7;
+        else if (Dist == 1) len = (x % 5) ? 1 + x % 7 : 8 + (x >> 8) % 57;
+        else len = 64;
+    }
+    return lens;
+}
+
+template <class List, std::size_t Dist>
+bench::Result small_lists() {
+    const auto lens = list_lengths<Dist>(bench::scaled(1u << 12));
+    double items = 0;
+    for (auto len : lens) items += static_cast<double>(len);
+    std::vector<List> lists(lens.size());
+    return bench::measure(items, [&] {
+        for (std::size_t i = 0; i < lens.size(); ++i)
+            for (std::size_t k = 0; k < lens[i]; ++k) lists[i].push_back(static_cast<int>(k));
+        long long s = 0;
+        for (auto& l : lists) for (int v : l) s += v;
+        bench::do_not_optimize(s);
+        for (auto& l : lists) l.clear();
+    });
+}
+
+using SmallPool = StaticPoolAllocator<int, (1u << 12) * 64>;
+
+// список, чьи узлы разбросаны по слабу случайно (после долгой "текучки"),
+// до и после compact()
+using FragList = SimpleForwardList<int, StaticPoolAllocator<int, kMaxKeys + 1>>;
+
+template <bool Compact, bool SlabScan = false>
+bench::Result list_iterate_fragmented() {
+    const std::size_t n = bench::scaled(kMaxKeys);
+    {
+        // одноэлементные списки, уничтоженные в случайном порядке, перемешивают free-list
+        std::vector<std::unique_ptr<FragList>> singles;
+        for (std::size_t i = 0; i < n; ++i) {
+            singles.push_back(std::make_unique<FragList>());
+            singles.back()->push_back(0);
+        }
+        const auto order = shuffled_keys(n);
+        for (int i : order) singles[static_cast<std::size_t>(i)].reset();
+    }
+    FragList l;
+    for (std::size_t i = 0; i < n; ++i) l.push_back(static_cast<int>(i));
+    if (Compact) l.compact();
+
+    constexpr int kPasses = 20;
+    bench::Result r = bench::measure(static_cast<double>(n) * kPasses, [&] {
+        for (int p = 0; p < kPasses; ++p) {
+            long long s = 0;
+            if (SlabScan) l.for_each_unordered([&](int x) { s += x; });
+            else for (int x : l) s += x;
+            bench::do_not_optimize(s);
+        }
+    });
+    r.bytes = static_cast<double>(n * sizeof(int)) * kPasses;
+    return r;
+}
+
+BENCH_CASE("map_churn/std_allocator", map_churn<std::map<int, int>>);
+BENCH_CASE("map_churn/pool",          map_churn<PoolMap>);
+BENCH_CASE("map_churn/adaptive_pool", map_churn<AdaptiveMap>);
+BENCH_CASE("list_build/std_allocator", list_build<SimpleForwardList<int>>);
+BENCH_CASE("list_build/pool",          list_build<PoolList>);
+BENCH_CASE("list_build/pool_index64",  list_build<PoolList, 6>);
+BENCH_CASE("list_build/pool_index8",   list_build<PoolList, 3>);
+BENCH_CASE("list_nth/no_index",        list_nth<-1>);
+BENCH_CASE("list_nth/index64",         list_nth<6>);
+BENCH_CASE("list_nth/index8",          list_nth<3>);
+BENCH_CASE("list_build_big/push_back_temporary", list_build_big<false>);
+BENCH_CASE("list_build_big/emplace_in_place",    list_build_big<true>);
+BENCH_CASE("small_lists/short/std_allocator",  small_lists<SimpleForwardList<int>, 0>);
+BENCH_CASE("small_lists/short/std_inline8",    small_lists<SimpleForwardList<int, std::allocator<int>, 8>, 0>);
+BENCH_CASE("small_lists/short/pool",           small_lists<SimpleForwardList<int, SmallPool>, 0>);
+BENCH_CASE("small_lists/short/pool_inline8",   small_lists<SimpleForwardList<int, SmallPool, 8>, 0>);
+BENCH_CASE("small_lists/mixed/std_allocator",  small_lists<SimpleForwardList<int>, 1>);
+BENCH_CASE("small_lists/mixed/std_inline8",    small_lists<SimpleForwardList<int, std::allocator<int>, 8>, 1>);
+BENCH_CASE("small_lists/mixed/pool",           small_lists<SimpleForwardList<int, SmallPool>, 1>);
+BENCH_CASE("small_lists/mixed/pool_inline8",   small_lists<SimpleForwardList<int, SmallPool, 8>, 1>);
+BENCH_CASE("small_lists/long64/std_allocator", small_lists<SimpleForwardList<int>, 2>);
+BENCH_CASE("small_lists/long64/pool",          small_lists<SimpleForwardList<int, SmallPool>, 2>);
+BENCH_CASE("small_lists/long64/pool_inline8",  small_lists<SimpleForwardList<int, SmallPool, 8>, 2>);
+BENCH_CASE("list_iterate/std_allocator", list_iterate<SimpleForwardList<int>>);
+BENCH_CASE("list_iterate/pool",          list_iterate<PoolList>);
+BENCH_CASE("list_iterate/pool_fragmented", list_iterate_fragmented<false>);
+BENCH_CASE("list_iterate/pool_compacted",  list_iterate_fragmented<true>);
+BENCH_CASE("list_iterate/pool_fragmented_slab_scan", list_iterate_fragmented<false, true>);
+
+} // namespace
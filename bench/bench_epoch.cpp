@@ -0,0 +1,108 @@
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include "alloc/epoch.hpp"
+#include "alloc/static_pool_allocator.hpp"
+#include "bench.hpp"
+
+namespace {
+
+constexpr std::size_t kNodes = 1u << 20;
+
+struct Node {
+    long long key;
+    Node*     next;
+};
+
+using NodeAlloc = StaticPoolAllocator<Node, kNodes + 2 * ebr::kMaxGarbage>;
+
+Node* make_node(std::size_t i) {
+    std::lock_guard<std::mutex> lock(ebr::pool_mutex<NodeAlloc>());
+    NodeAlloc a;
+    Node* n = a.allocate(1);
+    ::new (n) Node{static_cast<long long>(i), nullptr};
+    return n;
+}
+
+// по одному deallocate (и захвату mutex'а пула) на указатель
+void reclaim_each(void*, void* const* ps, std::size_t n) noexcept {
+    NodeAlloc a;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::lock_guard<std::mutex> lock(ebr::pool_mutex<NodeAlloc>());
+        a.deallocate(static_cast<Node*>(ps[i]), 1);
+    }
+}
+
+void reclaim_bulk(void*, void* const* ps, std::size_t n) noexcept {
+    std::lock_guard<std::mutex> lock(ebr::pool_mutex<NodeAlloc>());
+    NodeAlloc::deallocate_bulk(reinterpret_cast<Node* const*>(ps), n);
+}
+
+// выделение, снятие и отложенное освобождение узла - цикл "удаление из lock-free структуры"
+template <class Retire>
+bench::Result churn(Retire retire, void (*flush)()) {
+    const std::size_t n = bench::scaled(kNodes);
+    return bench::measure(static_cast<double>(n), [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            Node* p = make_node(i);
+            bench::do_not_optimize(p->key);
+            retire(p);
+        }
+        flush();
+    });
+}
+
+bench::Result ebr_per_pointer() {
+    return churn([](Node* p) { ebr::retire(p, &reclaim_each); }, [] { ebr::drain(); });
+}
+
+bench::Result ebr_bulk() {
+    return churn([](Node* p) { ebr::retire(p, &reclaim_bulk); }, [] { ebr::drain(); });
+}
+
+bench::Result ebr_retire_to_pool() {
+    return churn([](Node* p) { ebr::retire_to_pool<NodeAlloc>(p); }, [] { ebr::drain(); });
+}
+
+bench::Result hazard_pointers() {
+    return churn([](Node* p) { hp::retire(p, &reclaim_bulk); }, [] { hp::scan(); });
+}
+
+// читатель: вход в Guard и чтение защищённого указателя
+bench::Result ebr_guard() {
+    const std::size_t n = bench::scaled(kNodes) * 8;
+    static std::atomic<Node*> head{make_node(0)};
+    return bench::measure(static_cast<double>(n), [&] {
+        long long acc = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            ebr::Guard g;
+            acc += head.load(std::memory_order_acquire)->key;
+        }
+        bench::do_not_optimize(acc);
+    });
+}
+
+bench::Result hazard_protect() {
+    const std::size_t n = bench::scaled(kNodes) * 8;
+    static std::atomic<Node*> head{make_node(0)};
+    return bench::measure(static_cast<double>(n), [&] {
+        long long acc = 0;
+        hp::Hazard h;
+        for (std::size_t i = 0; i < n; ++i) {
+            acc += h.protect(head)->key;
+            h.reset();
+        }
+        bench::do_not_optimize(acc);
+    });
+}
+
+BENCH_CASE("epoch/retire/per_pointer",      ebr_per_pointer);
+BENCH_CASE("epoch/retire/bulk",             ebr_bulk);
+BENCH_CASE("epoch/retire/retire_to_pool",   ebr_retire_to_pool);
+BENCH_CASE("epoch/retire/hazard",           hazard_pointers);
+BENCH_CASE("epoch/read/guard",              ebr_guard);
+BENCH_CASE("epoch/read/hazard",             hazard_protect);
+
+} // namespace
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "alloc/simd/cpu_features.hpp"
+
+namespace bench {
+
+// выставляет уровень ISA на время кейса и возвращает прежний
+class IsaScope {
+public:
+    explicit IsaScope(simd::Isa isa) : prev_(simd::active_isa()), ok_(simd::force_isa(isa) == isa) {}
+    ~IsaScope() { simd::force_isa(prev_); }
+    bool ok() const noexcept { return ok_; }
+private:
+    simd::Isa prev_;
+    bool      ok_;
+};
+
+} // namespace bench
@@ -0,0 +1,67 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "alloc/numa.hpp"
+#include "alloc/simd/cpu_features.hpp"
+#include "bench.hpp"
+
+// использование: alloc_bench [--quick] [--list] [--isa=scalar|sse2|avx2|avx512]
+//                    [--numa-simulate=K] [фильтр...]
+int main(int argc, char** argv) {
+    std::vector<std::string> filters;
+    bool list_only = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--quick")) bench::scale() = 0.05;
+        else if (!std::strcmp(argv[i], "--list")) list_only = true;
+        else if (!std::strncmp(argv[i], "--numa-simulate=", 16)) numa::simulate(std::atoi(argv[i] + 16));
+        else if (!std::strncmp(argv[i], "--isa=", 6)) {
+            simd::Isa isa;
+            if (!simd::parse_isa(argv[i] + 6, isa)) {
+                std::fprintf(stderr, "unknown ISA '%s'\n", argv[i] + 6);
+                return 1;
+            }
+            simd::force_isa(isa);
+        }
+        else filters.emplace_back(argv[i]);
+    }
+
+    auto selected = [&](const std::string& name) {
+        if (filters.empty()) return true;
+        for (const auto& f : filters)
+            if (name.find(f) != std::string::npos) return true;
+        return false;
+    };
+
+#if ALLOC_BENCH_GLOBAL_NEW
+    const char* new_mode = "size-class pools";
+#else
+    const char* new_mode = "default";
+#endif
+    // в stderr: stdout - только строки результатов, их разбирает scripts/pgo.sh
+    std::fprintf(stderr, "# ISA: %s (detected %s), NUMA nodes: %d%s, operator new: %s\n",
+                 simd::isa_name(simd::active_isa()), simd::isa_name(simd::detect_isa()),
+                 numa::node_count(), numa::simulated() ? " (simulated)" : "", new_mode);
+
+    for (const auto& c : bench::registry()) {
+        if (!selected(c.name)) continue;
+        if (list_only) { std::printf("%s\n", c.name.c_str()); continue; }
+
+        bench::Result r = c.fn();
+        if (r.skipped) {
+            std::printf("%-48s %10s\n", c.name.c_str(), "skipped");
+            continue;
+        }
+        double ns_per_item = r.seconds * 1e9 / r.items;
+        double mitems      = r.items / r.seconds / 1e6;
+        if (r.bytes > 0)
+            std::printf("%-48s %10.2f ns/item %10.2f Mitems/s %8.2f GB/s\n",
+                        c.name.c_str(), ns_per_item, mitems, r.bytes / r.seconds / 1e9);
+        else
+            std::printf("%-48s %10.2f ns/item %10.2f Mitems/s\n",
+                        c.name.c_str(), ns_per_item, mitems);
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "alloc/numa_pool_allocator.hpp"
+#include "alloc/static_pool_allocator.hpp"
+#include "bench.hpp"
+
+namespace {
+
+constexpr std::size_t kPerThread = 1u << 14;
+constexpr std::size_t kThreads   = 4;
+
+struct Payload {
+    long v[8];
+};
+
+// общий пул под одним мьютексом - как один слаб из ensure_pool_ на все сокеты
+struct LockedPoolAllocator {
+    using Pool = StaticPoolAllocator<Payload, kPerThread * kThreads>;
+    static inline std::mutex m;
+    Payload* allocate(std::size_t n) { std::lock_guard<std::mutex> g(m); return Pool().allocate(n); }
+    void deallocate(Payload* p, std::size_t n) { std::lock_guard<std::mutex> g(m); Pool().deallocate(p, n); }
+};
+
+// каждый поток выделяет свои узлы, многократно проходит по ним и освобождает
+template <class Alloc>
+bench::Result alloc_touch_free() {
+    const std::size_t n = bench::scaled(kPerThread);
+    constexpr int kPasses = 8;
+    return bench::measure(static_cast<double>(n * kThreads * (kPasses + 2)), [&] {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < kThreads; ++t) {
+            threads.emplace_back([n] {
+                Alloc a;
+                std::vector<Payload*> ptrs(n);
+                for (auto& p : ptrs) {
+                    p = a.allocate(1);
+                    std::fill(std::begin(p->v), std::end(p->v), 1);
+                }
+                long s = 0;
+                for (int pass = 0; pass < kPasses; ++pass)
+                    for (auto p : ptrs) s += p->v[pass];
+                bench::do_not_optimize(s);
+                for (auto p : ptrs) a.deallocate(p, 1);
+            });
+        }
+        for (auto& th : threads) th.join();
+    }, 3);
+}
+
+BENCH_CASE("numa_pool/alloc_touch_free/numa_local", alloc_touch_free<NumaPoolAllocator<Payload, kPerThread * kThreads>>);
+BENCH_CASE("numa_pool/alloc_touch_free/locked_single_pool", alloc_touch_free<LockedPoolAllocator>);
+
+} // namespace
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "alloc/parallel.hpp"
+#include "bench.hpp"
+
+namespace {
+
+constexpr std::size_t kItems = 1u << 18;
+
+using PoolList = SimpleForwardList<double, StaticPoolAllocator<double, kItems>>;
+using PoolMap  = std::map<int, double, std::less<>,
+                          StaticPoolAllocator<std::pair<const int, double>, kItems + 2>>;
+
+std::vector<std::uint32_t> random_values(std::size_t n) {
+    std::vector<std::uint32_t> v(n);
+    std::uint32_t x = 2463534242u;
+    for (auto& e : v) { x ^= x << 13; x ^= x >> 17; x ^= x << 5; e = x; }
+    return v;
+}
+
+// нетривиальная работа на элемент, чтобы обход не упирался только в память
+inline double work(double x) { return std::sqrt(x * x + 1.0) * 0.5; }
+
+template <bool Parallel>
+bench::Result sort_values() {
+    const std::size_t n = bench::scaled(kItems * 4);
+    const auto src = random_values(n);
+    std::vector<std::uint32_t> v;
+    return bench::measure(static_cast<double>(n), [&] {
+        v = src;
+        if constexpr (Parallel) parallel::parallel_sort(v.begin(), v.end());
+        else std::sort(v.begin(), v.end());
+        bench::do_not_optimize(v.data());
+    });
+}
+
+template <bool Parallel, int IndexShift = -1>
+bench::Result list_for_each() {
+    const std::size_t n = bench::scaled(kItems);
+    PoolList l;
+    for (std::size_t i = 0; i < n; ++i) l.push_back(double(i));
+    if (IndexShift >= 0) l.build_index(IndexShift);
+    return bench::measure(static_cast<double>(n), [&] {
+        if constexpr (Parallel) parallel::parallel_for_each(l, [](double& x) { x = work(x); });
+        else for (double& x : l) x = work(x);
+        bench::clobber();
+    });
+}
+
+template <bool Parallel>
+bench::Result map_for_each() {
+    const std::size_t n = bench::scaled(kItems);
+    PoolMap m;
+    for (std::size_t i = 0; i < n; ++i) m.emplace_hint(m.end(), int(i), double(i));
+    return bench::measure(static_cast<double>(n), [&] {
+        auto fn = [](auto& kv) { kv.second = work(kv.second); };
+        if constexpr (Parallel) parallel::parallel_for_each(m.begin(), m.end(), fn);
+        else for (auto& kv : m) fn(kv);
+        bench::clobber();
+    });
+}
+
+// построение карты из неотсортированных пар: поэлементный emplace против bulk_load
+template <bool Bulk>
+bench::Result map_build() {
+    const std::size_t n = bench::scaled(kItems);
+    const auto keys = random_values(n);
+    std::vector<std::pair<int, double>> input(n);
+    for (std::size_t i = 0; i < n; ++i) input[i] = {int(keys[i] >> 1), double(i)};
+    return bench::measure(static_cast<double>(n), [&] {
+        PoolMap m;
+        if constexpr (Bulk) parallel::bulk_load(m, input.begin(), input.end());
+        else for (auto& kv : input) m.emplace(kv.first, kv.second);
+        bench::do_not_optimize(m.size());
+    });
+}
+
+// обход после построения: у bulk_load узлы лежат в слабе в порядке обхода
+template <bool Bulk>
+bench::Result map_iterate_after_build() {
+    const std::size_t n = bench::scaled(kItems);
+    const auto keys = random_values(n);
+    std::vector<std::pair<int, double>> input(n);
+    for (std::size_t i = 0; i < n; ++i) input[i] = {int(keys[i] >> 1), double(i)};
+    PoolMap m;
+    if constexpr (Bulk) parallel::bulk_load(m, input.begin(), input.end());
+    else for (auto& kv : input) m.emplace(kv.first, kv.second);
+    constexpr int kPasses = 10;
+    return bench::measure(static_cast<double>(m.size()) * kPasses, [&] {
+        for (int p = 0; p < kPasses; ++p) {
+            double s = 0;
+            for (const auto& kv : m) s += kv.second;
+            bench::do_not_optimize(s);
+        }
+    });
+}
+
+// стоимость пустой задачи: выделение из пула потока, дека, выполнение
+bench::Result task_spawn() {
+    const std::size_t n = bench::scaled(1u << 16);
+    TaskScheduler& s = TaskScheduler::instance();
+    return bench::measure(static_cast<double>(n), [&] {
+        TaskGroup g(s);
+        for (std::size_t i = 0; i < n; ++i) g.run([] { bench::clobber(); });
+        g.wait();
+    });
+}
+
+BENCH_CASE("parallel/sort_std", sort_values<false>);
+BENCH_CASE("parallel/sort_parallel", sort_values<true>);
+BENCH_CASE("parallel/list_for_each_seq", list_for_each<false>);
+BENCH_CASE("parallel/list_for_each_par", list_for_each<true>);
+BENCH_CASE("parallel/list_for_each_par_indexed", list_for_each<true, 6>);
+BENCH_CASE("parallel/map_for_each_seq", map_for_each<false>);
+BENCH_CASE("parallel/map_for_each_par", map_for_each<true>);
+BENCH_CASE("parallel/map_build_emplace", map_build<false>);
+BENCH_CASE("parallel/map_build_bulk_load", map_build<true>);
+BENCH_CASE("parallel/map_iterate_emplaced", map_iterate_after_build<false>);
+BENCH_CASE("parallel/map_iterate_bulk_loaded", map_iterate_after_build<true>);
+BENCH_CASE("parallel/task_spawn", task_spawn);
+
+} // namespace
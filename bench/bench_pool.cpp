@@ -0,0 +1,93 @@
+#include <memory>
+#include <vector>
+
+#include <chrono>
+#include <map>
+
+#include "alloc/adaptive_pool_allocator.hpp"
+#include "alloc/simple_forward_list.hpp"
+#include "alloc/static_pool_allocator.hpp"
+#include "bench.hpp"
+
+namespace {
+
+constexpr std::size_t kSlots = 1u << 16;
+
+// горячий путь: allocate - снятие с free-list, deallocate - возврат
+bench::Result pool_alloc_free_pair() {
+    using A = StaticPoolAllocator<long, kSlots>;
+    A a;
+    A::init();
+    const std::size_t n = bench::scaled(1u << 22);
+    return bench::measure(static_cast<double>(n), [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            long* p = a.allocate(1);
+            bench::do_not_optimize(p);
+            a.deallocate(p, 1);
+        }
+    });
+}
+
+// пачка выделений подряд, затем освобождение всех
+template <class Alloc>
+bench::Result alloc_burst() {
+    Alloc a;
+    const std::size_t n = bench::scaled(kSlots);
+    std::vector<long*> ptrs(n);
+    return bench::measure(static_cast<double>(n), [&] {
+        for (std::size_t i = 0; i < n; ++i) ptrs[i] = a.allocate(1);
+        bench::clobber();
+        for (std::size_t i = 0; i < n; ++i) a.deallocate(ptrs[i], 1);
+    });
+}
+
+bench::Result std_alloc_free_pair() {
+    std::allocator<long> a;
+    const std::size_t n = bench::scaled(1u << 22);
+    return bench::measure(static_cast<double>(n), [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            long* p = a.allocate(1);
+            bench::do_not_optimize(p);
+            a.deallocate(p, 1);
+        }
+    });
+}
+
+// Стоимость завершения: разрушение списка и map с миллионами узлов из пула.
+// Замеряется только разрушение; прогон один, т.к. после быстрого выхода ячейки
+// не возвращаются в пул (у каждого режима свои типы пулов).
+template <bool FastExit>
+bench::Result teardown() {
+    constexpr std::size_t kNodes = (1u << 21) + FastExit;
+    using List = SimpleForwardList<long, StaticPoolAllocator<long, kNodes>>;
+    using Map  = std::map<long, long, std::less<>, StaticPoolAllocator<std::pair<const long, long>, kNodes / 4 + 2>>;
+    const std::size_t n = bench::scaled(kNodes - 1);
+
+    auto l = std::make_unique<List>();
+    auto m = std::make_unique<Map>();
+    for (std::size_t i = 0; i < n; ++i) l->push_back(static_cast<long>(i));
+    for (std::size_t i = 0; i < n / 4; ++i) m->emplace(static_cast<long>(i), 0);
+
+    auto t0 = std::chrono::steady_clock::now();
+    if (FastExit) pool_fast_exit();
+    l.reset();
+    m.reset();
+    auto t1 = std::chrono::steady_clock::now();
+    detail::pool_fast_exit_flag.store(false);
+
+    bench::Result r;
+    r.seconds = std::chrono::duration<double>(t1 - t0).count();
+    r.items = static_cast<double>(n + n / 4);
+    return r;
+}
+
+BENCH_CASE("pool_teardown/normal",    teardown<false>);
+BENCH_CASE("pool_teardown/fast_exit", teardown<true>);
+
+BENCH_CASE("pool_hot_path/alloc_free_pair",     pool_alloc_free_pair);
+BENCH_CASE("pool_hot_path/std_alloc_free_pair", std_alloc_free_pair);
+BENCH_CASE("pool_hot_path/burst",               alloc_burst<StaticPoolAllocator<long, kSlots>>);
+BENCH_CASE("pool_hot_path/std_burst",           alloc_burst<std::allocator<long>>);
+BENCH_CASE("pool_hot_path/adaptive_burst",      alloc_burst<AdaptivePoolAllocator<long>>);
+
+} // namespace
@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "alloc/radix_tree.hpp"
+#include "alloc/static_pool_allocator.hpp"
+#include "bench.hpp"
+#include "bench_isa.hpp"
+
+namespace {
+
+constexpr std::size_t kKeys = 1u << 18;
+
+// та же карта, что в main(), только с ёмкостью под бенчмарк
+using PoolMap = std::map<int, int, std::less<>,
+                         StaticPoolAllocator<std::pair<const int, int>, kKeys + 2>>;
+using RadixMap = RadixTreeMap<int, int>;
+
+struct PoolMapOps {
+    PoolMap m;
+    void insert(int k, int v) { m.emplace(k, v); }
+    const int* find(int k) const { auto it = m.find(k); return it != m.end() ? &it->second : nullptr; }
+    template <class Fn> void for_each(Fn&& fn) const { for (auto& kv : m) fn(kv.first, kv.second); }
+};
+
+struct RadixOps {
+    RadixMap m;
+    void insert(int k, int v) { m.insert(k, v); }
+    const int* find(int k) const { return m.find(k); }
+    template <class Fn> void for_each(Fn&& fn) const { m.for_each(fn); }
+};
+
+// Dense - ключи подряд (узлы Node256 внизу), иначе разреженные случайные 32-битные
+std::vector<int> make_keys(std::size_t n, bool dense) {
+    std::vector<int> keys(n);
+    std::uint32_t x = 2463534242u;
+    for (std::size_t i = 0; i < n; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        keys[i] = dense ? static_cast<int>(i) : static_cast<int>(x);
+    }
+    if (dense) {
+        for (std::size_t i = n; i > 1; --i) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            std::swap(keys[i - 1], keys[x % i]);
+        }
+    }
+    return keys;
+}
+
+template <class Map, bool Dense>
+bench::Result build() {
+    const auto keys = make_keys(bench::scaled(kKeys), Dense);
+    return bench::measure(static_cast<double>(keys.size()), [&] {
+        Map m;
+        for (int k : keys) m.insert(k, k);
+        bench::do_not_optimize(m);
+    });
+}
+
+template <class Map, bool Dense, simd::Isa I = simd::Isa::avx512>
+bench::Result lookup() {
+    bench::IsaScope scope(I);
+    if (!scope.ok()) { bench::Result r; r.skipped = true; return r; }
+    const auto keys = make_keys(bench::scaled(kKeys), Dense);
+    Map m;
+    for (int k : keys) m.insert(k, k);
+    return bench::measure(static_cast<double>(keys.size()), [&] {
+        long long acc = 0;
+        for (int k : keys) acc += *m.find(k);
+        bench::do_not_optimize(acc);
+    });
+}
+
+template <class Map>
+bench::Result iterate() {
+    const auto keys = make_keys(bench::scaled(kKeys), false);
+    Map m;
+    for (int k : keys) m.insert(k, k);
+    return bench::measure(static_cast<double>(keys.size()), [&] {
+        long long acc = 0;
+        m.for_each([&](int k, int v) { acc += k ^ v; });
+        bench::do_not_optimize(acc);
+    });
+}
+
+BENCH_CASE("radix/build_sparse/pool_map",      build<PoolMapOps, false>);
+BENCH_CASE("radix/build_sparse/radix",         build<RadixOps, false>);
+BENCH_CASE("radix/build_dense/pool_map",       build<PoolMapOps, true>);
+BENCH_CASE("radix/build_dense/radix",          build<RadixOps, true>);
+BENCH_CASE("radix/find_sparse/pool_map",       lookup<PoolMapOps, false>);
+BENCH_CASE("radix/find_sparse/radix",          lookup<RadixOps, false>);
+BENCH_CASE("radix/find_sparse/radix_scalar16", lookup<RadixOps, false, simd::Isa::scalar>);
+BENCH_CASE("radix/find_dense/pool_map",        lookup<PoolMapOps, true>);
+BENCH_CASE("radix/find_dense/radix",           lookup<RadixOps, true>);
+BENCH_CASE("radix/iterate/pool_map",           iterate<PoolMapOps>);
+BENCH_CASE("radix/iterate/radix",              iterate<RadixOps>);
+
+} // namespace
@@ -0,0 +1,83 @@
+#include <atomic>
+#include <cstddef>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "alloc/rcu_forward_list.hpp"
+#include "alloc/simple_forward_list.hpp"
+#include "bench.hpp"
+
+namespace {
+
+constexpr int         kLen   = 1024;     // длина списка
+constexpr std::size_t kScans = 1u << 11; // обходов на читателя
+
+using Pool = StaticPoolAllocator<int, 1u << 18>;
+
+// то, что обычно пишут без RCU: читатели под shared_lock, писатель под unique_lock
+struct LockedList {
+    std::shared_mutex            m;
+    SimpleForwardList<int, Pool> list;
+
+    void append(int v) { std::unique_lock<std::shared_mutex> l(m); list.push_back(v); }
+    void drop_front() { std::unique_lock<std::shared_mutex> l(m); list.pop_front(); }
+    long long scan() {
+        std::shared_lock<std::shared_mutex> l(m);
+        long long s = 0;
+        for (int v : list) s += v;
+        return s;
+    }
+};
+
+struct RcuList {
+    RcuForwardList<int, Pool> list;
+
+    void append(int v) { list.push_back(v); }
+    void drop_front() { list.pop_front(); }
+    long long scan() {
+        long long s = 0;
+        for (int v : list.read()) s += v;
+        return s;
+    }
+};
+
+unsigned bench_readers() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n < 2 ? 1 : n - 1;
+}
+
+// читатели обходят список целиком, один писатель всё это время двигает окно:
+// добавляет в конец и снимает с головы
+template <class List>
+bench::Result readers_with_writer() {
+    const unsigned readers = bench_readers();
+    const std::size_t scans = bench::scaled(kScans);
+    return bench::measure(static_cast<double>(scans) * readers * kLen, [&] {
+        List list;
+        for (int i = 0; i < kLen; ++i) list.append(i);
+        std::atomic<unsigned> done{0};
+        std::thread writer([&] {
+            for (int i = kLen; done.load(std::memory_order_relaxed) < readers; ++i) {
+                list.append(i);
+                list.drop_front();
+            }
+        });
+        std::vector<std::thread> ts;
+        for (unsigned t = 0; t < readers; ++t) {
+            ts.emplace_back([&] {
+                long long acc = 0;
+                for (std::size_t i = 0; i < scans; ++i) acc += list.scan();
+                bench::do_not_optimize(acc);
+                done.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        for (auto& th : ts) th.join();
+        writer.join();
+    }, 3);
+}
+
+BENCH_CASE("rcu_list/scan_with_writer/rcu",         readers_with_writer<RcuList>);
+BENCH_CASE("rcu_list/scan_with_writer/shared_lock", readers_with_writer<LockedList>);
+
+} // namespace
@@ -0,0 +1,121 @@
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "alloc/reduction.hpp"
+#include "alloc/simple_forward_list.hpp"
+#include "alloc/slot_map.hpp"
+#include "bench.hpp"
+#include "bench_isa.hpp"
+
+namespace {
+
+constexpr std::size_t kN      = 1u << 18;
+constexpr int         kPasses = 20;
+
+using List = SimpleForwardList<int, StaticPoolAllocator<int, kN + 1>>;
+using Dense = SlotMap<int, kN>;
+
+// Fragmented - узлы разбросаны по слабу, как после долгой "текучки";
+// Compact - после compact() слаб занят одной серией в порядке списка.
+// Список один на все кейсы: он - единственный пользователь пула.
+List& make_list(bool fragmented, bool compact = false) {
+    static List l;
+    l.clear();
+    const std::size_t n = bench::scaled(kN);
+    if (fragmented) {
+        std::vector<std::unique_ptr<List>> singles;
+        for (std::size_t i = 0; i < n; ++i) {
+            singles.push_back(std::make_unique<List>());
+            singles.back()->push_back(0);
+        }
+        std::uint32_t x = 2463534242u;
+        for (std::size_t i = n; i > 1; --i) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            std::swap(singles[i - 1], singles[x % i]);
+        }
+        singles.clear();
+    }
+    for (std::size_t i = 0; i < n; ++i) l.push_back(static_cast<int>(i * 2654435761u));
+    if (compact) l.compact();
+    return l;
+}
+
+// Mode: 0 - обход по ссылкам списка, 1 - reduction (серии слаба) на выбранном ISA
+template <bool Fragmented, bool Compact, int Mode, simd::Isa I = simd::Isa::avx512>
+bench::Result list_sum() {
+    bench::IsaScope scope(I);
+    if (!scope.ok()) { bench::Result r; r.skipped = true; return r; }
+    List& l = make_list(Fragmented, Compact);
+    bench::Result r = bench::measure(static_cast<double>(l.size()) * kPasses, [&] {
+        for (int p = 0; p < kPasses; ++p) {
+            long long s = 0;
+            if (Mode == 0) for (int x : l) s += x;
+            else s = reduction::sum(l);
+            bench::do_not_optimize(s);
+        }
+    });
+    r.bytes = static_cast<double>(l.size() * sizeof(int)) * kPasses;
+    return r;
+}
+
+template <int Mode>
+bench::Result list_count_if() {
+    List& l = make_list(true);
+    bench::Result r = bench::measure(static_cast<double>(l.size()) * kPasses, [&] {
+        for (int p = 0; p < kPasses; ++p) {
+            std::size_t c = 0;
+            if (Mode == 0) { for (int x : l) c += x < 0; }
+            else c = reduction::count_if(l, [](int x) { return x < 0; });
+            bench::do_not_optimize(c);
+        }
+    });
+    r.bytes = static_cast<double>(l.size() * sizeof(int)) * kPasses;
+    return r;
+}
+
+// плотные данные SlotMap: Mode 0 - цикл по begin/end, 1 - reduction
+template <int Mode, simd::Isa I = simd::Isa::avx512>
+bench::Result dense_min_max() {
+    bench::IsaScope scope(I);
+    if (!scope.ok()) { bench::Result r; r.skipped = true; return r; }
+    static Dense m;
+    const std::size_t n = bench::scaled(kN);
+    if (m.size() != n) {
+        m.clear();
+        for (std::size_t i = 0; i < n; ++i) m.emplace(static_cast<int>(i * 2654435761u));
+    }
+    bench::Result r = bench::measure(static_cast<double>(n) * kPasses, [&] {
+        for (int p = 0; p < kPasses; ++p) {
+            long long s = 0;
+            if (Mode == 0) {
+                int lo = m.data()[0], hi = lo;
+                for (int x : m) { s += x; lo = x < lo ? x : lo; hi = x > hi ? x : hi; }
+                s += lo + hi;
+            } else {
+                const auto st = reduction::stats(m);
+                s = st.sum + st.min + st.max;
+            }
+            bench::do_not_optimize(s);
+        }
+    });
+    r.bytes = static_cast<double>(n * sizeof(int)) * kPasses;
+    return r;
+}
+
+BENCH_CASE("reduce_sum/list_fragmented/chase",        list_sum<true, false, 0>);
+BENCH_CASE("reduce_sum/list_fragmented/runs_scalar",  list_sum<true, false, 1, simd::Isa::scalar>);
+BENCH_CASE("reduce_sum/list_fragmented/runs_avx2",    list_sum<true, false, 1, simd::Isa::avx2>);
+BENCH_CASE("reduce_sum/list_fragmented/runs_avx512",  list_sum<true, false, 1, simd::Isa::avx512>);
+BENCH_CASE("reduce_sum/list_compacted/chase",         list_sum<true, true, 0>);
+BENCH_CASE("reduce_sum/list_compacted/runs_scalar",   list_sum<true, true, 1, simd::Isa::scalar>);
+BENCH_CASE("reduce_sum/list_compacted/runs_avx512",   list_sum<true, true, 1, simd::Isa::avx512>);
+BENCH_CASE("reduce_count_if/list_fragmented/chase",   list_count_if<0>);
+BENCH_CASE("reduce_count_if/list_fragmented/runs",    list_count_if<1>);
+BENCH_CASE("reduce_stats/slot_map/loop",              dense_min_max<0>);
+BENCH_CASE("reduce_stats/slot_map/scalar",            dense_min_max<1, simd::Isa::scalar>);
+BENCH_CASE("reduce_stats/slot_map/sse2",              dense_min_max<1, simd::Isa::sse2>);
+BENCH_CASE("reduce_stats/slot_map/avx2",              dense_min_max<1, simd::Isa::avx2>);
+BENCH_CASE("reduce_stats/slot_map/avx512",            dense_min_max<1, simd::Isa::avx512>);
+
+} // namespace
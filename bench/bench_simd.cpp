@@ -0,0 +1,132 @@
+#include <cstdint>
+#include <vector>
+
+#include "alloc/simd/kernels.hpp"
+#include "alloc/simd/search.hpp"
+#include "alloc/size_class_pool.hpp"
+#include "bench.hpp"
+#include "bench_isa.hpp"
+
+namespace {
+
+using bench::IsaScope;
+
+// линейное пробирование по окнам разной длины
+template <simd::Isa I>
+bench::Result find_eq() {
+    IsaScope scope(I);
+    if (!scope.ok()) { bench::Result r; r.skipped = true; return r; }
+
+    const std::size_t n = bench::scaled(1u << 20);
+    std::vector<std::int32_t> data(n);
+    for (std::size_t i = 0; i < n; ++i) data[i] = static_cast<std::int32_t>(i * 2654435761u);
+    constexpr std::size_t kWindow = 64;
+
+    bench::Result r = bench::measure(static_cast<double>(n), [&] {
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i + kWindow <= n; i += kWindow)
+            hits += simd::find_eq(data.data() + i, kWindow, data[i + kWindow - 1]);
+        bench::do_not_optimize(hits);
+    });
+    r.bytes = static_cast<double>(n * sizeof(std::int32_t));
+    return r;
+}
+
+// поиск в узлах из Width отсортированных ключей: много узлов подряд, ключ -
+// случайный, так что позиция ответа и ветвление скалярного кода непредсказуемы
+template <class T, std::size_t Width, simd::Isa I>
+bench::Result lower_bound() {
+    IsaScope scope(I);
+    if (!scope.ok()) { bench::Result r; r.skipped = true; return r; }
+
+    const std::size_t nodes = bench::scaled(1u << 16);
+    std::vector<T> keys(nodes * Width);
+    for (std::size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<T>(i * 16);
+    std::vector<T> probes(nodes);
+    std::uint32_t x = 2463534242u;
+    for (std::size_t i = 0; i < nodes; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        probes[i] = static_cast<T>((i * Width + x % (Width + 1)) * 16 - 1);
+    }
+
+    bench::Result r = bench::measure(static_cast<double>(nodes), [&] {
+        std::size_t acc = 0;
+        for (std::size_t i = 0; i < nodes; ++i) acc += simd::lower_bound(keys.data() + i * Width, Width, probes[i]);
+        bench::do_not_optimize(acc);
+    });
+    r.bytes = static_cast<double>(keys.size() * sizeof(T));
+    return r;
+}
+
+// поиск класса по размеру и класса по адресу (delete без размера)
+template <simd::Isa I>
+bench::Result class_of() {
+    IsaScope scope(I);
+    if (!scope.ok()) { bench::Result r; r.skipped = true; return r; }
+    const std::size_t n = bench::scaled(1u << 20);
+    return bench::measure(static_cast<double>(n), [&] {
+        std::size_t acc = 0;
+        std::uint32_t x = 2463534242u;
+        for (std::size_t i = 0; i < n; ++i) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            acc += size_class::class_of(1 + x % size_class::kMaxSize);
+        }
+        bench::do_not_optimize(acc);
+    });
+}
+
+template <simd::Isa I>
+bench::Result owner_of() {
+    IsaScope scope(I);
+    if (!scope.ok()) { bench::Result r; r.skipped = true; return r; }
+    std::vector<void*> blocks;
+    for (std::size_t c = 0; c < size_class::kClasses; ++c) blocks.push_back(size_class::allocate(size_class::kSizes[c]));
+    const std::size_t n = bench::scaled(1u << 20);
+    bench::Result r = bench::measure(static_cast<double>(n), [&] {
+        std::size_t acc = 0;
+        std::uint32_t x = 2463534242u;
+        for (std::size_t i = 0; i < n; ++i) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            acc += size_class::owner_of(blocks[x % blocks.size()]);
+        }
+        bench::do_not_optimize(acc);
+    });
+    for (std::size_t c = 0; c < blocks.size(); ++c) size_class::deallocate(blocks[c], size_class::kSizes[c]);
+    return r;
+}
+
+BENCH_CASE("simd_find_eq_i32/scalar", find_eq<simd::Isa::scalar>);
+BENCH_CASE("simd_find_eq_i32/sse2",   find_eq<simd::Isa::sse2>);
+BENCH_CASE("simd_find_eq_i32/avx2",   find_eq<simd::Isa::avx2>);
+BENCH_CASE("simd_find_eq_i32/avx512", find_eq<simd::Isa::avx512>);
+
+BENCH_CASE("simd_lower_bound_i32/4/scalar",     lower_bound<std::int32_t, 4, simd::Isa::scalar>);
+BENCH_CASE("simd_lower_bound_i32/4/sse2",       lower_bound<std::int32_t, 4, simd::Isa::sse2>);
+BENCH_CASE("simd_lower_bound_i32/4/avx2",       lower_bound<std::int32_t, 4, simd::Isa::avx2>);
+BENCH_CASE("simd_lower_bound_i32/4/avx512",     lower_bound<std::int32_t, 4, simd::Isa::avx512>);
+BENCH_CASE("simd_lower_bound_i32/8/scalar",     lower_bound<std::int32_t, 8, simd::Isa::scalar>);
+BENCH_CASE("simd_lower_bound_i32/8/sse2",       lower_bound<std::int32_t, 8, simd::Isa::sse2>);
+BENCH_CASE("simd_lower_bound_i32/8/avx2",       lower_bound<std::int32_t, 8, simd::Isa::avx2>);
+BENCH_CASE("simd_lower_bound_i32/8/avx512",     lower_bound<std::int32_t, 8, simd::Isa::avx512>);
+BENCH_CASE("simd_lower_bound_i32/16/scalar",    lower_bound<std::int32_t, 16, simd::Isa::scalar>);
+BENCH_CASE("simd_lower_bound_i32/16/sse2",      lower_bound<std::int32_t, 16, simd::Isa::sse2>);
+BENCH_CASE("simd_lower_bound_i32/16/avx2",      lower_bound<std::int32_t, 16, simd::Isa::avx2>);
+BENCH_CASE("simd_lower_bound_i32/16/avx512",    lower_bound<std::int32_t, 16, simd::Isa::avx512>);
+BENCH_CASE("simd_lower_bound_i64/4/scalar",     lower_bound<std::int64_t, 4, simd::Isa::scalar>);
+BENCH_CASE("simd_lower_bound_i64/4/sse2",       lower_bound<std::int64_t, 4, simd::Isa::sse2>);
+BENCH_CASE("simd_lower_bound_i64/4/avx2",       lower_bound<std::int64_t, 4, simd::Isa::avx2>);
+BENCH_CASE("simd_lower_bound_i64/4/avx512",     lower_bound<std::int64_t, 4, simd::Isa::avx512>);
+BENCH_CASE("simd_lower_bound_i64/8/scalar",     lower_bound<std::int64_t, 8, simd::Isa::scalar>);
+BENCH_CASE("simd_lower_bound_i64/8/sse2",       lower_bound<std::int64_t, 8, simd::Isa::sse2>);
+BENCH_CASE("simd_lower_bound_i64/8/avx2",       lower_bound<std::int64_t, 8, simd::Isa::avx2>);
+BENCH_CASE("simd_lower_bound_i64/8/avx512",     lower_bound<std::int64_t, 8, simd::Isa::avx512>);
+BENCH_CASE("simd_lower_bound_i64/16/scalar",    lower_bound<std::int64_t, 16, simd::Isa::scalar>);
+BENCH_CASE("simd_lower_bound_i64/16/sse2",      lower_bound<std::int64_t, 16, simd::Isa::sse2>);
+BENCH_CASE("simd_lower_bound_i64/16/avx2",      lower_bound<std::int64_t, 16, simd::Isa::avx2>);
+BENCH_CASE("simd_lower_bound_i64/16/avx512",    lower_bound<std::int64_t, 16, simd::Isa::avx512>);
+BENCH_CASE("size_class_class_of/scalar",        class_of<simd::Isa::scalar>);
+BENCH_CASE("size_class_class_of/avx512",        class_of<simd::Isa::avx512>);
+BENCH_CASE("size_class_owner_of/scalar",        owner_of<simd::Isa::scalar>);
+BENCH_CASE("size_class_owner_of/avx512",        owner_of<simd::Isa::avx512>);
+
+} // namespace
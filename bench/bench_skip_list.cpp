@@ -0,0 +1,95 @@
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "alloc/concurrent_skip_list.hpp"
+#include "bench.hpp"
+
+namespace {
+
+constexpr int         kKeys   = 1 << 16;
+constexpr std::size_t kOps    = 1u << 18; // на поток
+
+using PoolMap = std::map<int, int, std::less<>,
+                         StaticPoolAllocator<std::pair<const int, int>, kKeys + 2>>;
+
+// карта под одним mutex'ом - то, что обычно пишут вместо конкурентной структуры
+struct LockedMap {
+    std::mutex m;
+    PoolMap    map;
+
+    bool insert(int k, int v) { std::lock_guard<std::mutex> l(m); return map.emplace(k, v).second; }
+    bool erase(int k) { std::lock_guard<std::mutex> l(m); return map.erase(k) != 0; }
+    bool contains(int k) { std::lock_guard<std::mutex> l(m); return map.find(k) != map.end(); }
+    long long scan(int lo, int hi) {
+        std::lock_guard<std::mutex> l(m);
+        long long s = 0;
+        for (auto it = map.lower_bound(lo); it != map.end() && it->first < hi; ++it) s += it->second;
+        return s;
+    }
+};
+
+struct SkipMap {
+    ConcurrentSkipList list;
+
+    bool insert(int k, int v) { return list.insert(k, v); }
+    bool erase(int k) { return list.erase(k); }
+    bool contains(int k) { return list.contains(k); }
+    long long scan(int lo, int hi) {
+        long long s = 0;
+        list.for_each_in_range(lo, hi, [&](int, int v) { s += v; });
+        return s;
+    }
+};
+
+unsigned bench_threads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n < 2 ? 2 : n;
+}
+
+// ReadPct% поиска, остальное поровну вставка/удаление; ScanPct% из поисков -
+// обход диапазона из 64 ключей
+template <class Map, int ReadPct, int ScanPct = 0>
+bench::Result mixed() {
+    const unsigned threads = bench_threads();
+    const std::size_t ops = bench::scaled(kOps);
+    Map map;
+    for (int k = 0; k < kKeys; k += 2) map.insert(k, k);
+    return bench::measure(static_cast<double>(ops) * threads, [&] {
+        std::vector<std::thread> ts;
+        for (unsigned t = 0; t < threads; ++t) {
+            ts.emplace_back([&, t] {
+                std::uint32_t x = 2463534242u + t * 7919u;
+                long long acc = 0;
+                for (std::size_t i = 0; i < ops; ++i) {
+                    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+                    const int key = static_cast<int>(x % kKeys);
+                    const int dice = static_cast<int>((x >> 16) % 100);
+                    if (dice < ReadPct) {
+                        if (ScanPct && dice < ReadPct * ScanPct / 100) acc += map.scan(key, key + 64);
+                        else acc += map.contains(key);
+                    } else if (dice & 1) {
+                        map.insert(key, key);
+                    } else {
+                        map.erase(key);
+                    }
+                }
+                bench::do_not_optimize(acc);
+            });
+        }
+        for (auto& th : ts) th.join();
+    });
+}
+
+BENCH_CASE("skip_list/read90/skip_list",      mixed<SkipMap, 90>);
+BENCH_CASE("skip_list/read90/locked_map",     mixed<LockedMap, 90>);
+BENCH_CASE("skip_list/read50/skip_list",      mixed<SkipMap, 50>);
+BENCH_CASE("skip_list/read50/locked_map",     mixed<LockedMap, 50>);
+BENCH_CASE("skip_list/scan10/skip_list",      mixed<SkipMap, 90, 10>);
+BENCH_CASE("skip_list/scan10/locked_map",     mixed<LockedMap, 90, 10>);
+
+} // namespace
@@ -0,0 +1,60 @@
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "alloc/slot_map.hpp"
+#include "bench.hpp"
+
+namespace {
+
+constexpr std::size_t kEntities = 1u << 16;
+
+struct Entity {
+    float x, y, vx, vy;
+};
+
+// доступ по handle против id -> указатель через хеш-таблицу
+bench::Result slot_map_resolve() {
+    static SlotMap<Entity, kEntities> sm;
+    sm.clear();
+    const std::size_t n = bench::scaled(kEntities);
+    std::vector<PoolHandle> handles;
+    for (std::size_t i = 0; i < n; ++i) handles.push_back(sm.insert({float(i), 0, 1, 1}));
+    return bench::measure(static_cast<double>(n), [&] {
+        float s = 0;
+        for (auto h : handles) s += sm.get(h)->x;
+        bench::do_not_optimize(s);
+    });
+}
+
+bench::Result unordered_map_resolve() {
+    const std::size_t n = bench::scaled(kEntities);
+    std::vector<Entity> storage(n);
+    std::unordered_map<std::uint64_t, Entity*> index;
+    for (std::size_t i = 0; i < n; ++i) {
+        storage[i] = {float(i), 0, 1, 1};
+        index.emplace(i, &storage[i]);
+    }
+    return bench::measure(static_cast<double>(n), [&] {
+        float s = 0;
+        for (std::size_t i = 0; i < n; ++i) s += index.find(i)->second->x;
+        bench::do_not_optimize(s);
+    });
+}
+
+bench::Result slot_map_iterate() {
+    static SlotMap<Entity, kEntities> sm;
+    sm.clear();
+    const std::size_t n = bench::scaled(kEntities);
+    for (std::size_t i = 0; i < n; ++i) sm.insert({float(i), 0, 1, 1});
+    return bench::measure(static_cast<double>(n), [&] {
+        for (auto& e : sm) { e.x += e.vx; e.y += e.vy; }
+        bench::clobber();
+    });
+}
+
+BENCH_CASE("slot_map/resolve", slot_map_resolve);
+BENCH_CASE("slot_map/resolve_unordered_map", unordered_map_resolve);
+BENCH_CASE("slot_map/iterate", slot_map_iterate);
+
+} // namespace
@@ -0,0 +1,64 @@
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.hpp"
+
+// Обычный код на std::allocator: сравнивается между alloc_bench и
+// alloc_bench_global_new, где тот же код идёт через size_class-пулы.
+namespace {
+
+constexpr std::size_t kItems = 1u << 16;
+
+// как m1 в демо: std::map<int,int> на std::allocator
+bench::Result std_map_build() {
+    const std::size_t n = bench::scaled(kItems);
+    return bench::measure(static_cast<double>(n), [&] {
+        std::map<int, int> m;
+        for (std::size_t i = 0; i < n; ++i) m.emplace(int(i * 2654435761u), int(i));
+        bench::do_not_optimize(m.size());
+    });
+}
+
+bench::Result unordered_map_strings() {
+    const std::size_t n = bench::scaled(kItems);
+    std::vector<std::string> keys;
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) keys.push_back("key-with-long-prefix-" + std::to_string(i));
+    return bench::measure(static_cast<double>(n), [&] {
+        std::unordered_map<std::string, int> m;
+        for (std::size_t i = 0; i < n; ++i) m.emplace(keys[i], int(i));
+        bench::do_not_optimize(m.size());
+    });
+}
+
+bench::Result list_churn() {
+    const std::size_t n = bench::scaled(kItems);
+    return bench::measure(static_cast<double>(n) * 2, [&] {
+        std::list<std::uint64_t> l;
+        for (std::size_t i = 0; i < n; ++i) l.push_back(i);
+        while (!l.empty()) l.pop_front();
+        bench::clobber();
+    });
+}
+
+bench::Result shared_ptr_make() {
+    const std::size_t n = bench::scaled(kItems);
+    return bench::measure(static_cast<double>(n), [&] {
+        std::vector<std::shared_ptr<std::uint64_t>> v;
+        v.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) v.push_back(std::make_shared<std::uint64_t>(i));
+        bench::do_not_optimize(v.data());
+    });
+}
+
+BENCH_CASE("stl/std_map_build", std_map_build);
+BENCH_CASE("stl/unordered_map_strings", unordered_map_strings);
+BENCH_CASE("stl/list_churn", list_churn);
+BENCH_CASE("stl/shared_ptr_make", shared_ptr_make);
+
+} // namespace
@@ -0,0 +1,42 @@
+# Profile-guided optimization.
+#   PGO_PHASE=GENERATE  инструментированная сборка, профили пишутся в PGO_PROFILE_DIR
+#   PGO_PHASE=USE       пересборка с собранным профилем
+# Полный цикл instrument/train/use с отчётом: scripts/pgo.sh
+
+set(PGO_PHASE "GENERATE" CACHE STRING "PGO phase: GENERATE or USE")
+set_property(CACHE PGO_PHASE PROPERTY STRINGS GENERATE USE)
+set(PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo-profile" CACHE PATH "Directory for PGO profile data")
+
+if(ENABLE_PGO)
+  if(NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+    message(FATAL_ERROR "ENABLE_PGO is supported only with GCC and Clang")
+  endif()
+  if(NOT PGO_PHASE MATCHES "^(GENERATE|USE)$")
+    message(FATAL_ERROR "PGO_PHASE must be GENERATE or USE, got '${PGO_PHASE}'")
+  endif()
+  message(STATUS "PGO: phase ${PGO_PHASE}, profile dir ${PGO_PROFILE_DIR}")
+endif()
+
+function(alloc_apply_pgo tgt)
+  if(NOT ENABLE_PGO)
+    return()
+  endif()
+
+  if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    if(PGO_PHASE STREQUAL "GENERATE")
+      set(flags -fprofile-generate=${PGO_PROFILE_DIR} -fprofile-update=prefer-atomic)
+    else()
+      set(flags -fprofile-use=${PGO_PROFILE_DIR} -fprofile-partial-training -Wno-missing-profile)
+    endif()
+  else()
+    # clang: сырые .profraw нужно слить в default.profdata через llvm-profdata merge
+    if(PGO_PHASE STREQUAL "GENERATE")
+      set(flags -fprofile-generate=${PGO_PROFILE_DIR})
+    else()
+      set(flags -fprofile-use=${PGO_PROFILE_DIR}/default.profdata -Wno-profile-instr-unprofiled)
+    endif()
+  endif()
+
+  target_compile_options(${tgt} PRIVATE ${flags})
+  target_link_options(${tgt} PRIVATE ${flags})
+endfunction()
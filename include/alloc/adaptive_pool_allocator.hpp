@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "alloc/pool_profile.hpp"
+#include "alloc/static_pool_allocator.hpp"
+
+// Пул без фиксированного N: ячейки нарезаются из кусков, каждый следующий
+// вдвое больше предыдущего. Первый кусок берётся по пику из профиля пулов
+// (pool_profile::hint), так что после профилирующего прогона с
+// ALLOC_POOL_PROFILE пул сразу занимает один непрерывный кусок нужного размера.
+// Как и StaticPoolAllocator - однопоточный, состояние общее для типа T.
+template <class T>
+class AdaptivePoolAllocator {
+public:
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type; // у каждого T свой пул
+
+    template <class U> struct rebind { using other = AdaptivePoolAllocator<U>; };
+
+    // размер первого куска без подсказки профиля
+    static constexpr size_type kMinChunk = 64;
+
+    AdaptivePoolAllocator() noexcept = default;
+    template <class U>
+    AdaptivePoolAllocator(const AdaptivePoolAllocator<U>&) noexcept {}
+
+    pointer allocate(size_type n) {
+        if (n == 0) return nullptr;
+        if (n != 1) throw std::bad_alloc();
+
+        FreeNode* p = state_.free_list;
+        if (p) {
+            ALLOC_ASAN_UNPOISON(p, sizeof(storage_t));
+            state_.free_list = p->next;
+        } else {
+            p = carve_();
+        }
+        if (++state_.live > state_.peak) state_.peak = state_.live;
+        return reinterpret_cast<pointer>(p);
+    }
+
+    void deallocate(pointer p, size_type) noexcept {
+        if (!p || ALLOC_UNLIKELY(pool_fast_exit_enabled())) return;
+        auto node = reinterpret_cast<FreeNode*>(p);
+        node->next = state_.free_list;
+        state_.free_list = node;
+        ALLOC_ASAN_POISON(p, sizeof(storage_t));
+        // пул опустел - нарезка снова с первого куска (кроме случая, когда
+        // нарезано меньше kMinChunk ячеек: тогда free-list и так почти упорядочен)
+        if (ALLOC_UNLIKELY(--state_.live == 0) && (state_.cur != state_.head || state_.bump > kMinChunk)) {
+            state_.free_list = nullptr;
+            state_.cur = state_.head;
+            state_.bump = 0;
+        }
+    }
+
+    // возврат пачки ячеек одним проходом (см. StaticPoolAllocator::deallocate_bulk)
+    static void deallocate_bulk(pointer const* ps, size_type n) noexcept {
+        if (n == 0 || ALLOC_UNLIKELY(pool_fast_exit_enabled())) return;
+        FreeNode* head = state_.free_list;
+        for (size_type i = 0; i < n; ++i) {
+            auto node = reinterpret_cast<FreeNode*>(ps[i]);
+            node->next = head;
+            head = node;
+            ALLOC_ASAN_POISON(ps[i], sizeof(storage_t));
+        }
+        state_.free_list = head;
+        state_.live -= n;
+        if (ALLOC_UNLIKELY(state_.live == 0) && (state_.cur != state_.head || state_.bump > kMinChunk)) {
+            state_.free_list = nullptr;
+            state_.cur = state_.head;
+            state_.bump = 0;
+        }
+    }
+
+    // гарантирует ёмкость не меньше n ячеек одним куском в конце цепочки
+    static void reserve(size_type n) {
+        if (state_.capacity >= n) return;
+        add_chunk_(n - state_.capacity);
+    }
+
+    static size_type live_count() noexcept { return state_.live; }
+    static size_type peak_count() noexcept { return state_.peak; }
+    static size_type capacity() noexcept { return state_.capacity; }
+    static size_type chunk_count() noexcept {
+        size_type k = 0;
+        for (Chunk* c = state_.head; c; c = c->next) ++k;
+        return k;
+    }
+
+    template <class U>
+    bool operator==(const AdaptivePoolAllocator<U>&) const noexcept { return std::is_same_v<T, U>; }
+    template <class U>
+    bool operator!=(const AdaptivePoolAllocator<U>& other) const noexcept { return !(*this == other); }
+
+private:
+    struct FreeNode { FreeNode* next; };
+
+    using storage_t = std::aligned_storage_t<
+        (sizeof(T) > sizeof(FreeNode) ? sizeof(T) : sizeof(FreeNode)),
+        (alignof(T) > alignof(FreeNode) ? alignof(T) : alignof(FreeNode))>;
+
+    // заголовок куска; ячейки идут сразу за ним
+    struct alignas(storage_t) Chunk {
+        Chunk*    next;
+        size_type cap;
+        storage_t* slots() noexcept { return reinterpret_cast<storage_t*>(this + 1); }
+    };
+
+    static constexpr std::align_val_t kChunkAlign{alignof(Chunk)};
+
+    struct State {
+        Chunk*    head      = nullptr; // куски в порядке выделения
+        Chunk*    tail      = nullptr;
+        Chunk*    cur       = nullptr; // кусок, из которого идёт нарезка
+        size_type bump      = 0;       // нарезано ячеек в cur
+        FreeNode* free_list = nullptr;
+        size_type live      = 0;
+        size_type peak      = 0;
+        size_type capacity  = 0;       // ячеек во всех кусках
+        // деструктора нет - по той же причине, что у StaticPoolAllocator::State
+    };
+    static inline State state_{};
+
+    struct Reaper {
+        ~Reaper() {
+            if (ALLOC_POOL_IMMORTAL || state_.live != 0) return;
+            for (Chunk* c = state_.head; c; ) {
+                Chunk* next = c->next;
+                ::operator delete(static_cast<void*>(c), kChunkAlign);
+                c = next;
+            }
+            const size_type peak = state_.peak; // нужен профилю, который пишется позже
+            state_ = State{};
+            state_.peak = peak;
+        }
+    };
+    static inline Reaper reaper_{};
+
+    static void add_chunk_(size_type cap) {
+        (void)&reaper_;
+        void* mem = ::operator new(sizeof(Chunk) + sizeof(storage_t) * cap, kChunkAlign);
+        auto c = ::new (mem) Chunk{nullptr, cap};
+        ALLOC_ASAN_POISON(c->slots(), sizeof(storage_t) * cap);
+        if (state_.tail) state_.tail->next = c;
+        else {
+            state_.head = c;
+            pool_profile::record(pool_profile::type_name<AdaptivePoolAllocator>(), &peak_count);
+        }
+        state_.tail = c;
+        if (!state_.cur) state_.cur = c;
+        state_.capacity += cap;
+    }
+
+    // free-list пуст: следующая ячейка текущего куска, следующий кусок или новый
+    ALLOC_NOINLINE static FreeNode* carve_() {
+        while (state_.cur && state_.bump == state_.cur->cap) {
+            state_.cur = state_.cur->next;
+            state_.bump = 0;
+        }
+        if (!state_.cur) {
+            size_type cap = state_.tail ? state_.tail->cap * 2 : kMinChunk;
+            if (!state_.tail) {
+                const size_type h = pool_profile::hint(pool_profile::type_name<AdaptivePoolAllocator>());
+                if (h > cap) cap = h;
+            }
+            add_chunk_(cap);
+            state_.cur = state_.tail;
+            state_.bump = 0;
+        }
+        storage_t* s = state_.cur->slots() + state_.bump++;
+        ALLOC_ASAN_UNPOISON(s, sizeof(storage_t));
+        return reinterpret_cast<FreeNode*>(s);
+    }
+};
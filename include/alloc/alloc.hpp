@@ -0,0 +1,21 @@
+#pragma once
+
+// общий заголовок библиотеки: аллокаторы и контейнеры
+#include "alloc/static_pool_allocator.hpp"
+#include "alloc/adaptive_pool_allocator.hpp"
+#include "alloc/simple_forward_list.hpp"
+#include "alloc/slot_map.hpp"
+#include "alloc/numa_pool_allocator.hpp"
+#include "alloc/size_class_pool.hpp"
+#include "alloc/frame_pool.hpp"
+#include "alloc/simd/kernels.hpp"
+#include "alloc/simd/search.hpp"
+#include "alloc/simd/reduce.hpp"
+#include "alloc/task_scheduler.hpp"
+#include "alloc/parallel.hpp"
+#include "alloc/epoch.hpp"
+#include "alloc/rcu_forward_list.hpp"
+#include "alloc/radix_tree.hpp"
+#include "alloc/reduction.hpp"
+#include "alloc/concurrent_skip_list.hpp"
+#include "alloc/async_channel.hpp"
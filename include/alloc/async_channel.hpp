@@ -0,0 +1,224 @@
+#pragma once
+
+// Асинхронный канал на корутинах C++20. В режиме C++17 заголовок пуст
+// (ALLOC_HAVE_COROUTINES == 0), чтобы его можно было включать безусловно.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define ALLOC_HAVE_COROUTINES 1
+#else
+#define ALLOC_HAVE_COROUTINES 0
+#endif
+
+#if ALLOC_HAVE_COROUTINES
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "alloc/frame_pool.hpp"
+#include "alloc/simple_forward_list.hpp"
+
+// Корутина "запустил и забыл" с кадром из size_class-пула: стартует сразу, после
+// завершения остаётся приостановленной, кадр освобождает деструктор.
+// Разрушать можно только завершённую задачу (или ни разу не ждавшую канала).
+class AsyncTask {
+public:
+    struct promise_type : PooledPromise {
+        AsyncTask get_return_object() noexcept {
+            return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+
+        std::exception_ptr error;
+    };
+
+    AsyncTask() = default;
+    AsyncTask(AsyncTask&& r) noexcept : h_(std::exchange(r.h_, nullptr)) {}
+    AsyncTask& operator=(AsyncTask&& r) noexcept {
+        if (this != &r) {
+            if (h_) h_.destroy();
+            h_ = std::exchange(r.h_, nullptr);
+        }
+        return *this;
+    }
+    ~AsyncTask() { if (h_) h_.destroy(); }
+
+    bool done() const noexcept { return !h_ || h_.done(); }
+
+    // пробрасывает исключение, которым завершилась корутина
+    void rethrow_if_failed() const {
+        if (h_ && h_.promise().error) std::rethrow_exception(h_.promise().error);
+    }
+
+private:
+    explicit AsyncTask(std::coroutine_handle<promise_type> h) noexcept : h_(h) {}
+
+    std::coroutine_handle<promise_type> h_;
+};
+
+// Ограниченный канал: co_await ch.push(v) -> bool (false, если канал закрыт),
+// co_await ch.pop() -> std::optional<T> (пусто, если закрыт и опустел).
+// Буфер - SimpleForwardList на аллокаторе Alloc; ожидающие корутины хранятся
+// интрусивно в своих awaiter'ах и будятся прямо в потоке, освободившем место
+// или давшем значение. capacity == 0 - рандеву без буфера.
+// mutex_ защищает только свой канал, а пул узлов StaticPoolAllocator /
+// AdaptivePoolAllocator - общий для всех каналов того же типа и не
+// потокобезопасен. Такие аллокаторы - только если все каналы этого типа живут
+// в одном потоке; канал между потоками - на потокобезопасном Alloc (std::allocator).
+template <class T, class Alloc = std::allocator<T>>
+class Channel {
+    struct Waiter {
+        std::coroutine_handle<> h;
+        Waiter* next = nullptr;
+    };
+
+    // FIFO ожидающих
+    struct WaitQueue {
+        Waiter* head = nullptr;
+        Waiter* tail = nullptr;
+
+        bool empty() const noexcept { return !head; }
+        void push(Waiter* w) noexcept {
+            w->next = nullptr;
+            if (tail) tail->next = w; else head = w;
+            tail = w;
+        }
+        Waiter* pop() noexcept {
+            Waiter* w = head;
+            head = w->next;
+            if (!head) tail = nullptr;
+            return w;
+        }
+    };
+
+public:
+    class PushAwaiter : Waiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> h) { return ch_.suspend_push_(*this, h); }
+        bool await_resume() const noexcept { return ok_; }
+
+    private:
+        friend class Channel;
+        PushAwaiter(Channel& ch, T&& v) : ch_(ch), value_(std::move(v)) {}
+
+        Channel& ch_;
+        T        value_;
+        bool     ok_ = false;
+    };
+
+    class PopAwaiter : Waiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> h) { return ch_.suspend_pop_(*this, h); }
+        std::optional<T> await_resume() { return std::move(value_); }
+
+    private:
+        friend class Channel;
+        explicit PopAwaiter(Channel& ch) noexcept : ch_(ch) {}
+
+        Channel&         ch_;
+        std::optional<T> value_;
+    };
+
+    explicit Channel(std::size_t capacity, const Alloc& a = Alloc())
+        : items_(a), capacity_(capacity) {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    PushAwaiter push(T v) { return PushAwaiter(*this, std::move(v)); }
+    PopAwaiter pop() noexcept { return PopAwaiter(*this); }
+
+    // Закрытие: ждущие push получают false, ждущие pop - пустой optional;
+    // уже лежащие в буфере значения ещё можно забрать.
+    void close() {
+        WaitQueue pushers, poppers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            std::swap(pushers, push_waiters_);
+            std::swap(poppers, pop_waiters_);
+        }
+        while (!pushers.empty()) pushers.pop()->h.resume();
+        while (!poppers.empty()) poppers.pop()->h.resume();
+    }
+
+    bool closed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_;
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    // true - корутина приостановлена и будет разбужена потребителем или close()
+    bool suspend_push_(PushAwaiter& a, std::coroutine_handle<> h) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (closed_) return false;
+        if (!pop_waiters_.empty()) {
+            auto w = static_cast<PopAwaiter*>(pop_waiters_.pop());
+            w->value_.emplace(std::move(a.value_));
+            a.ok_ = true;
+            lock.unlock();
+            w->h.resume();
+            return false;
+        }
+        if (items_.size() < capacity_) {
+            items_.push_back(std::move(a.value_));
+            a.ok_ = true;
+            return false;
+        }
+        a.h = h;
+        push_waiters_.push(&a);
+        return true;
+    }
+
+    bool suspend_pop_(PopAwaiter& a, std::coroutine_handle<> h) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        PushAwaiter* w = nullptr;
+        if (!items_.empty()) {
+            a.value_.emplace(std::move(items_.front()));
+            items_.pop_front();
+            // освободилось место - первый ждущий производитель кладёт своё значение
+            if (!push_waiters_.empty()) {
+                w = static_cast<PushAwaiter*>(push_waiters_.pop());
+                items_.push_back(std::move(w->value_));
+            }
+        } else if (!push_waiters_.empty()) {
+            // рандеву: буфер пуст, значение берётся прямо у производителя
+            w = static_cast<PushAwaiter*>(push_waiters_.pop());
+            a.value_.emplace(std::move(w->value_));
+        } else if (!closed_) {
+            a.h = h;
+            pop_waiters_.push(&a);
+            return true;
+        }
+        lock.unlock();
+        if (w) {
+            w->ok_ = true;
+            w->h.resume();
+        }
+        return false;
+    }
+
+    mutable std::mutex        mutex_;
+    SimpleForwardList<T, Alloc> items_;
+    std::size_t               capacity_;
+    bool                      closed_ = false;
+    WaitQueue                 push_waiters_;
+    WaitQueue                 pop_waiters_;
+};
+
+#endif // ALLOC_HAVE_COROUTINES
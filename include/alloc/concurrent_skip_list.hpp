@@ -0,0 +1,241 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "alloc/epoch.hpp"
+#include "alloc/size_class_pool.hpp"
+
+// Конкурентная упорядоченная карта int -> int: lock-free skip list
+// (Herlihy-Shavit с пометкой удаления младшим битом ссылки). Башни узлов
+// переменной высоты берутся из size_class-пулов с кэшем потока, снятые узлы
+// возвращаются в пул через EBR. Поиск, вставка, удаление и обход
+// диапазона безопасны из любых потоков; деструктор - только без конкуренции.
+class ConcurrentSkipList {
+public:
+    static constexpr int kMaxHeight = 16;
+
+    ConcurrentSkipList() : head_(make_node_(0, 0, kMaxHeight)) {}
+
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    ~ConcurrentSkipList() {
+        for (Node* n = head_; n; ) {
+            Node* next = ptr_(n->link(0).load(std::memory_order_relaxed));
+            free_node_(n);
+            n = next;
+        }
+    }
+
+    // false - ключ уже есть (значение не меняется)
+    bool insert(int key, int value) { return insert_(key, value, false); }
+    // вставка или замена значения; true - ключа не было
+    bool insert_or_assign(int key, int value) { return insert_(key, value, true); }
+
+    bool erase(int key) {
+        Guard g;
+        Node* preds[kMaxHeight];
+        Node* succs[kMaxHeight];
+        if (!find_(key, preds, succs)) return false;
+        Node* node = succs[0];
+        // верхние уровни помечаются сверху вниз, нижний - последним: кто пометил
+        // нижний, тот и удалил
+        for (int lv = node->height - 1; lv >= 1; --lv) {
+            std::uintptr_t s = node->link(lv).load();
+            while (!marked_(s) && !node->link(lv).compare_exchange_weak(s, s | 1)) {}
+        }
+        std::uintptr_t s = node->link(0).load();
+        for (;;) {
+            if (marked_(s)) return false;
+            if (node->link(0).compare_exchange_weak(s, s | 1)) break;
+        }
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        find_(key, preds, succs); // снимает узел со всех уровней
+        finish_(node, kRemoverDone);
+        return true;
+    }
+
+    std::optional<int> find(int key) const {
+        Guard g;
+        Node* n = lower_bound_(key);
+        if (n && n->key == key) return n->value.load(std::memory_order_acquire);
+        return std::nullopt;
+    }
+
+    bool contains(int key) const { return find(key).has_value(); }
+
+    // fn(key, value) для ключей из [lo, hi) по возрастанию; не снимок -
+    // параллельные изменения могут быть видны частично
+    template <class Fn>
+    void for_each_in_range(int lo, int hi, Fn&& fn) const {
+        Guard g;
+        for (Node* n = lower_bound_(lo); n && n->key < hi; n = ptr_(n->link(0).load())) {
+            if (!marked_(n->link(0).load())) fn(n->key, n->value.load(std::memory_order_acquire));
+        }
+    }
+
+    // приблизительный размер при конкурентных изменениях
+    std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+private:
+    using Guard = ebr::Guard;
+
+    static constexpr std::uint8_t kInserterDone = 1;
+    static constexpr std::uint8_t kRemoverDone  = 2;
+
+    // Ссылки - seq_cst (по умолчанию): вставка верхнего уровня и удаление
+    // разбирают гонку "связал помеченный узел" / "уже снял", что требует
+    // единого порядка записей ссылок и чтения пометок. На x86 это даром:
+    // записи всё равно идут через CAS.
+    struct alignas(alignof(std::atomic<std::uintptr_t>)) Node {
+        int              key;
+        std::atomic<int> value;
+        int              height;
+        std::atomic<std::uint8_t> done{0}; // кто закончил с узлом: вставка и/или удаление
+
+        std::atomic<std::uintptr_t>& link(int lv) noexcept {
+            return reinterpret_cast<std::atomic<std::uintptr_t>*>(this + 1)[lv];
+        }
+    };
+
+    static std::size_t node_bytes_(int height) noexcept {
+        return sizeof(Node) + sizeof(std::atomic<std::uintptr_t>) * std::size_t(height);
+    }
+
+    static Node* make_node_(int key, int value, int height) {
+        const std::size_t bytes = node_bytes_(height);
+        void* mem = size_class::allocate(bytes);
+        if (!mem) mem = ::operator new(bytes);
+        Node* n = ::new (mem) Node{key, {value}, height};
+        for (int lv = 0; lv < height; ++lv) ::new (&n->link(lv)) std::atomic<std::uintptr_t>(0);
+        return n;
+    }
+
+    static void free_node_(Node* n) noexcept {
+        const std::size_t bytes = node_bytes_(n->height);
+        n->~Node();
+        if (!size_class::deallocate(n, bytes)) ::operator delete(n, bytes);
+    }
+
+    static Node* ptr_(std::uintptr_t v) noexcept { return reinterpret_cast<Node*>(v & ~std::uintptr_t(1)); }
+    static bool marked_(std::uintptr_t v) noexcept { return v & 1; }
+
+    // высота башни: геометрическое распределение с p = 1/2
+    static int random_height_() noexcept {
+        thread_local std::uint32_t x = 2463534242u ^ static_cast<std::uint32_t>(
+            std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        int h = 1;
+        for (std::uint32_t bits = x; (bits & 1) && h < kMaxHeight; bits >>= 1) ++h;
+        return h;
+    }
+
+    // Второй из закончивших (вставка или удаление) отдаёт узел в EBR:
+    // к этому моменту узел снят со всех уровней, и никто его больше не свяжет.
+    static void finish_(Node* n, std::uint8_t who) {
+        if (n->done.fetch_or(who, std::memory_order_acq_rel) != 0)
+            ebr::retire(n, &reclaim_nodes_);
+    }
+
+    static void reclaim_nodes_(void*, void* const* ps, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) free_node_(static_cast<Node*>(ps[i]));
+    }
+
+    // Поиск предшественников и преемников key на всех уровнях; попутно снимает
+    // помеченные узлы. Вызывается под Guard.
+    bool find_(int key, Node** preds, Node** succs) const {
+    retry:
+        Node* pred = head_;
+        for (int lv = kMaxHeight - 1; lv >= 0; --lv) {
+            Node* curr = ptr_(pred->link(lv).load());
+            while (curr) {
+                std::uintptr_t succ = curr->link(lv).load();
+                while (marked_(succ)) {
+                    std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(curr);
+                    if (!pred->link(lv).compare_exchange_strong(expected, succ & ~std::uintptr_t(1)))
+                        goto retry;
+                    curr = ptr_(succ);
+                    if (!curr) break;
+                    succ = curr->link(lv).load();
+                }
+                if (!curr || curr->key >= key) break;
+                pred = curr;
+                curr = ptr_(succ);
+            }
+            preds[lv] = pred;
+            succs[lv] = curr;
+        }
+        return succs[0] && succs[0]->key == key;
+    }
+
+    // первый непомеченный узел с ключом >= key, без снятия помеченных (только чтение)
+    Node* lower_bound_(int key) const {
+        Node* pred = head_;
+        Node* curr = nullptr;
+        for (int lv = kMaxHeight - 1; lv >= 0; --lv) {
+            curr = ptr_(pred->link(lv).load());
+            while (curr) {
+                std::uintptr_t succ = curr->link(lv).load();
+                if (marked_(succ)) { curr = ptr_(succ); continue; }
+                if (curr->key >= key) break;
+                pred = curr;
+                curr = ptr_(succ);
+            }
+        }
+        return curr;
+    }
+
+    bool insert_(int key, int value, bool assign) {
+        Guard g;
+        Node* preds[kMaxHeight];
+        Node* succs[kMaxHeight];
+        Node* node = nullptr;
+        int h = 0;
+        for (;;) {
+            if (find_(key, preds, succs)) {
+                if (assign) succs[0]->value.store(value, std::memory_order_release);
+                if (node) free_node_(node); // не был опубликован
+                return false;
+            }
+            if (!node) {
+                h = random_height_();
+                node = make_node_(key, value, h);
+            }
+            for (int lv = 0; lv < h; ++lv)
+                node->link(lv).store(reinterpret_cast<std::uintptr_t>(succs[lv]), std::memory_order_relaxed);
+            std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(succs[0]);
+            if (preds[0]->link(0).compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(node))) break;
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+
+        for (int lv = 1; lv < h; ++lv) {
+            for (;;) {
+                Node* succ = succs[lv];
+                std::uintptr_t cur = node->link(lv).load();
+                if (marked_(cur)) goto linked; // узел уже удаляют
+                if (ptr_(cur) != succ &&
+                    !node->link(lv).compare_exchange_strong(cur, reinterpret_cast<std::uintptr_t>(succ)))
+                    goto linked; // ссылку на этом уровне меняет только пометка
+                std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(succ);
+                if (preds[lv]->link(lv).compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(node)))
+                    break;
+                find_(key, preds, succs);
+                if (succs[0] != node) goto linked; // уже снят с нижнего уровня
+            }
+        }
+    linked:
+        // удаление могло проскочить между уровнями - добираем то, что связали после него
+        if (marked_(node->link(0).load())) find_(key, preds, succs);
+        finish_(node, kInserterDone);
+        return true;
+    }
+
+    Node*                    head_;
+    std::atomic<std::size_t> size_{0};
+};
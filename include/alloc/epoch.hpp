@@ -0,0 +1,432 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Отложенное освобождение узлов lock-free структур.
+//
+// ebr:: - освобождение по эпохам. Читатель держит ebr::Guard на время обхода;
+// снятый из структуры узел отдаётся в ebr::retire и освобождается, когда все
+// потоки, которые могли его видеть, вышли из своих Guard (две смены эпохи).
+// Узлы копятся пачками в потоке и возвращаются в пул пачкой (deallocate_bulk).
+// Мусор потока ограничен kMaxGarbage: сверх него retire ждёт смены эпохи, а
+// если он вызван внутри своего Guard (ждать там нельзя - эпоха держится этим
+// же потоком), ждёт деструктор внешнего Guard.
+//
+// hp:: - указатели опасности для случаев, когда читатель может надолго
+// застрять внутри обхода: держит только явно защищённые узлы, мусор ограничен
+// всегда, но каждый шаг обхода дороже.
+namespace ebr {
+
+// освобождает n указателей одной пачкой; ctx - что передали в retire
+using Reclaim = void (*)(void* ctx, void* const* ptrs, std::size_t n) noexcept;
+
+inline constexpr std::size_t kMaxThreads = 256;
+inline constexpr std::size_t kBagSize    = 128;       // пачка мусора потока
+inline constexpr std::size_t kMaxGarbage = 1u << 16;  // предел неосвобождённого на поток
+
+namespace detail {
+
+struct Retired {
+    void*   p;
+    Reclaim fn;
+    void*   ctx;
+};
+
+struct Bag {
+    std::uint64_t epoch = 0; // эпоха запечатывания: свободна при глобальной >= epoch + 2
+    std::size_t   n = 0;
+    Bag*          next = nullptr;
+    Retired       items[kBagSize];
+};
+
+// 0 - поток вне Guard, иначе закреплённая эпоха
+struct alignas(64) Record {
+    std::atomic<std::uint64_t> state{0};
+    std::atomic<bool>          used{false};
+};
+
+inline std::atomic<std::uint64_t> g_epoch{2};
+inline Record                     g_records[kMaxThreads];
+
+// пачки завершившихся потоков доосвобождают живые
+inline std::mutex g_orphans_mutex;
+inline Bag*       g_orphans = nullptr;
+
+// Пачка освобождается группами с общими (fn, ctx): на каждую группу один вызов fn.
+inline void free_bag(Bag* b) noexcept {
+    std::sort(b->items, b->items + b->n, [](const Retired& x, const Retired& y) {
+        const auto fx = reinterpret_cast<std::uintptr_t>(x.fn), fy = reinterpret_cast<std::uintptr_t>(y.fn);
+        return fx != fy ? fx < fy : reinterpret_cast<std::uintptr_t>(x.ctx) < reinterpret_cast<std::uintptr_t>(y.ctx);
+    });
+    void* ptrs[kBagSize];
+    for (std::size_t i = 0; i < b->n; ) {
+        std::size_t j = i;
+        for (; j < b->n && b->items[j].fn == b->items[i].fn && b->items[j].ctx == b->items[i].ctx; ++j)
+            ptrs[j - i] = b->items[j].p;
+        b->items[i].fn(b->items[i].ctx, ptrs, j - i);
+        i = j;
+    }
+    b->n = 0;
+}
+
+struct Local {
+    Record*     rec = nullptr;
+    unsigned    depth = 0;
+    Bag*        cur = nullptr;         // заполняемая пачка
+    Bag*        limbo_head = nullptr;  // запечатанные, в порядке эпох
+    Bag*        limbo_tail = nullptr;
+    Bag*        spare = nullptr;       // одна пустая пачка про запас
+    std::size_t garbage = 0;
+
+    ~Local() {
+        seal();
+        if (limbo_head) {
+            std::lock_guard<std::mutex> lock(g_orphans_mutex);
+            limbo_tail->next = g_orphans;
+            g_orphans = limbo_head;
+        }
+        delete spare;
+        if (rec) rec->used.store(false, std::memory_order_release);
+    }
+
+    void seal() {
+        if (!cur || cur->n == 0) return;
+        // снятие узлов из структуры (обычно release-запись) - до чтения эпохи пачки
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cur->epoch = g_epoch.load(std::memory_order_seq_cst);
+        cur->next = nullptr;
+        if (limbo_tail) limbo_tail->next = cur; else limbo_head = cur;
+        limbo_tail = cur;
+        cur = nullptr;
+    }
+
+    Bag* fresh_bag() {
+        if (Bag* b = spare) { spare = nullptr; return b; }
+        return new Bag;
+    }
+};
+
+inline Local& local() {
+    thread_local Local l;
+    if (!l.rec) {
+        for (;;) {
+            for (auto& r : g_records) {
+                bool expected = false;
+                if (!r.used.load(std::memory_order_relaxed) &&
+                    r.used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    l.rec = &r;
+                    return l;
+                }
+            }
+            std::this_thread::yield(); // все записи заняты - ждём завершения потоков
+        }
+    }
+    return l;
+}
+
+inline void collect_orphans(std::uint64_t e) {
+    std::unique_lock<std::mutex> lock(g_orphans_mutex, std::try_to_lock);
+    if (!lock) return;
+    for (Bag** pp = &g_orphans; *pp; ) {
+        Bag* b = *pp;
+        if (b->epoch + 2 <= e) {
+            *pp = b->next;
+            free_bag(b);
+            delete b;
+        } else {
+            pp = &b->next;
+        }
+    }
+}
+
+} // namespace detail
+
+// Закрепление эпохи на время обхода; вложенные Guard дёшевы.
+class Guard {
+public:
+    Guard() : l_(detail::local()) {
+        if (l_.depth++ == 0) {
+            l_.rec->state.store(detail::g_epoch.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+            // объявление эпохи должно стать видимым до чтений под Guard (store -> load),
+            // иначе try_advance может его не увидеть, а читатель - получить старый узел
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+    ~Guard();
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+private:
+    detail::Local& l_;
+};
+
+// эпоха сдвигается, когда все потоки внутри Guard уже её видели
+inline bool try_advance() noexcept {
+    std::uint64_t e = detail::g_epoch.load(std::memory_order_seq_cst);
+    for (auto& r : detail::g_records) {
+        const std::uint64_t s = r.state.load(std::memory_order_seq_cst);
+        if (s != 0 && s != e) return false;
+    }
+    return detail::g_epoch.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+}
+
+// освобождает пачки потока, чей срок прошёл; текущая незаполненная запечатывается
+inline void collect() {
+    detail::Local& l = detail::local();
+    l.seal();
+    try_advance();
+    const std::uint64_t e = detail::g_epoch.load(std::memory_order_seq_cst);
+    while (l.limbo_head && l.limbo_head->epoch + 2 <= e) {
+        detail::Bag* b = l.limbo_head;
+        l.limbo_head = b->next;
+        if (!l.limbo_head) l.limbo_tail = nullptr;
+        l.garbage -= b->n;
+        detail::free_bag(b);
+        if (!l.spare) l.spare = b; else delete b;
+    }
+    detail::collect_orphans(e);
+}
+
+namespace detail {
+
+// предел мусора: ждём, пока застрявшие читатели выйдут из Guard; только вне Guard
+inline void bound_garbage(Local& l) {
+    while (l.garbage > kMaxGarbage) {
+        std::this_thread::yield();
+        collect();
+    }
+}
+
+} // namespace detail
+
+// неосвобождённый мусор текущего потока
+inline std::size_t pending() noexcept { return detail::local().garbage; }
+
+// Отложенное освобождение p: fn(ctx, {p...}, n) вызовется, когда ни один
+// читатель не сможет держать p. Вызывать после того, как p снят из структуры.
+inline void retire(void* p, Reclaim fn, void* ctx = nullptr) {
+    detail::Local& l = detail::local();
+    if (!l.cur) l.cur = l.fresh_bag();
+    l.cur->items[l.cur->n++] = {p, fn, ctx};
+    ++l.garbage;
+    if (l.cur->n < kBagSize) return;
+    collect();
+    if (l.depth == 0) detail::bound_garbage(l);
+}
+
+inline Guard::~Guard() {
+    if (--l_.depth != 0) return;
+    l_.rec->state.store(0, std::memory_order_release);
+    // мусор, набранный retire внутри этого Guard, ограничивается здесь
+    if (l_.garbage > kMaxGarbage) detail::bound_garbage(l_);
+}
+
+// Ждёт полного периода ожидания: все Guard, открытые до вызова, закрыты.
+// Нельзя вызывать изнутри Guard.
+inline void synchronize() {
+    const std::uint64_t target = detail::g_epoch.load(std::memory_order_seq_cst) + 2;
+    while (detail::g_epoch.load(std::memory_order_seq_cst) < target) {
+        if (!try_advance()) std::this_thread::yield();
+    }
+}
+
+// освобождает весь мусор текущего потока (при разрушении структуры, в тестах)
+inline void drain() {
+    detail::Local& l = detail::local();
+    l.seal();
+    while (l.limbo_head) {
+        synchronize();
+        collect();
+    }
+}
+
+// Однопоточные пулы (StaticPoolAllocator, AdaptivePoolAllocator) общие для типа,
+// поэтому и mutex для освобождения из EBR - один на тип аллокатора. Структура,
+// отдающая узлы пула в EBR, выделяет их под этим же mutex'ом.
+template <class Alloc>
+std::mutex& pool_mutex() {
+    static std::mutex m;
+    return m;
+}
+
+namespace detail {
+
+template <class A, class = void>
+struct has_deallocate_bulk : std::false_type {};
+template <class A>
+struct has_deallocate_bulk<A, std::void_t<decltype(A::deallocate_bulk(
+                                  std::declval<typename A::value_type* const*>(), std::size_t{}))>>
+    : std::true_type {};
+
+template <class Alloc>
+void reclaim_to_pool(void*, void* const* ptrs, std::size_t n) noexcept {
+    using T = typename Alloc::value_type;
+    using Traits = std::allocator_traits<Alloc>;
+    Alloc a;
+    for (std::size_t i = 0; i < n; ++i) Traits::destroy(a, static_cast<T*>(ptrs[i]));
+    std::lock_guard<std::mutex> lock(pool_mutex<Alloc>());
+    if constexpr (has_deallocate_bulk<Alloc>::value) {
+        Alloc::deallocate_bulk(reinterpret_cast<T* const*>(ptrs), n);
+    } else {
+        for (std::size_t i = 0; i < n; ++i) Traits::deallocate(a, static_cast<T*>(ptrs[i]), 1);
+    }
+}
+
+} // namespace detail
+
+// узел из пула Alloc: разрушение и возврат в пул пачкой под pool_mutex<Alloc>()
+template <class Alloc>
+void retire_to_pool(typename Alloc::value_type* p) {
+    retire(p, &detail::reclaim_to_pool<Alloc>);
+}
+
+} // namespace ebr
+
+namespace hp {
+
+inline constexpr std::size_t kSlotsPerThread = 4;
+inline constexpr std::size_t kScanThreshold  = 2 * ebr::kMaxThreads;
+
+namespace detail {
+
+struct alignas(64) Record {
+    std::atomic<bool>  used{false};
+    std::atomic<void*> slots[kSlotsPerThread] = {};
+};
+
+inline Record g_records[ebr::kMaxThreads];
+
+inline std::mutex                        g_orphans_mutex;
+inline std::vector<ebr::detail::Retired> g_orphans;
+
+struct Local {
+    Record*  rec = nullptr;
+    unsigned busy = 0; // занятые слоты, битовая маска
+    std::vector<ebr::detail::Retired> retired;
+
+    ~Local() {
+        if (!retired.empty()) {
+            std::lock_guard<std::mutex> lock(g_orphans_mutex);
+            g_orphans.insert(g_orphans.end(), retired.begin(), retired.end());
+        }
+        if (rec) rec->used.store(false, std::memory_order_release);
+    }
+};
+
+inline Local& local() {
+    thread_local Local l;
+    if (!l.rec) {
+        for (;;) {
+            for (auto& r : g_records) {
+                bool expected = false;
+                if (!r.used.load(std::memory_order_relaxed) &&
+                    r.used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    l.rec = &r;
+                    return l;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+    return l;
+}
+
+// освобождает из list всё, что не защищено ни одним слотом
+inline void scan_list(std::vector<ebr::detail::Retired>& list) {
+    // пара к барьеру в Hazard::protect: снятие узлов - до чтения слотов
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::vector<void*> hazards;
+    for (auto& r : g_records) {
+        if (!r.used.load(std::memory_order_acquire)) continue;
+        for (auto& s : r.slots)
+            if (void* p = s.load(std::memory_order_seq_cst)) hazards.push_back(p);
+    }
+    std::sort(hazards.begin(), hazards.end());
+    ebr::detail::Bag bag;
+    std::size_t keep = 0;
+    for (auto& item : list) {
+        if (std::binary_search(hazards.begin(), hazards.end(), item.p)) {
+            list[keep++] = item;
+            continue;
+        }
+        bag.items[bag.n++] = item;
+        if (bag.n == ebr::kBagSize) ebr::detail::free_bag(&bag);
+    }
+    ebr::detail::free_bag(&bag);
+    list.resize(keep);
+}
+
+} // namespace detail
+
+// Слот указателя опасности текущего потока (не больше kSlotsPerThread одновременно).
+class Hazard {
+public:
+    Hazard() {
+        detail::Local& l = detail::local();
+        slot_ = 0;
+        while (slot_ < kSlotsPerThread && (l.busy & (1u << slot_))) ++slot_;
+        // проверка и в release: иначе сдвиг за пределы busy и запись мимо slots
+        if (slot_ >= kSlotsPerThread) {
+            std::fprintf(stderr, "hp::Hazard: больше %u слотов в потоке\n", unsigned(kSlotsPerThread));
+            std::abort();
+        }
+        l.busy |= 1u << slot_;
+        rec_ = l.rec;
+    }
+    ~Hazard() {
+        reset();
+        detail::local().busy &= ~(1u << slot_);
+    }
+    Hazard(const Hazard&) = delete;
+    Hazard& operator=(const Hazard&) = delete;
+
+    // читает src и защищает прочитанное: повтор, пока значение не устоится
+    template <class T>
+    T* protect(const std::atomic<T*>& src) noexcept {
+        T* p = src.load(std::memory_order_acquire);
+        for (;;) {
+            rec_->slots[slot_].store(p, std::memory_order_seq_cst);
+            // store -> load: без полного барьера повторное чтение может обогнать
+            // запись слота, и scan() освободит узел, не увидев его в слотах
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            T* again = src.load(std::memory_order_acquire);
+            if (again == p) return p;
+            p = again;
+        }
+    }
+
+    void reset() noexcept { rec_->slots[slot_].store(nullptr, std::memory_order_release); }
+
+private:
+    detail::Record* rec_;
+    unsigned        slot_;
+};
+
+// p освобождается, когда его не держит ни один Hazard; мусор потока <= kScanThreshold + все слоты
+inline void retire(void* p, ebr::Reclaim fn, void* ctx = nullptr) {
+    detail::Local& l = detail::local();
+    l.retired.push_back({p, fn, ctx});
+    if (l.retired.size() < kScanThreshold) return;
+    detail::scan_list(l.retired);
+    std::unique_lock<std::mutex> lock(detail::g_orphans_mutex, std::try_to_lock);
+    if (lock && !detail::g_orphans.empty()) detail::scan_list(detail::g_orphans);
+}
+
+// освобождает всё незащищённое из мусора потока и оставшегося от завершённых потоков
+inline void scan() {
+    detail::scan_list(detail::local().retired);
+    std::lock_guard<std::mutex> lock(detail::g_orphans_mutex);
+    if (!detail::g_orphans.empty()) detail::scan_list(detail::g_orphans);
+}
+
+} // namespace hp
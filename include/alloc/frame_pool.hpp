@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "alloc/size_class_pool.hpp"
+
+// База для promise_type (и любых часто создаваемых объектов): operator new/delete
+// класса идут в size_class-пул с кэшем потока, крупные кадры - в кучу.
+//
+//     struct promise_type : PooledPromise { ... };
+struct PooledPromise {
+    static void* operator new(std::size_t n) {
+        if (void* p = size_class::allocate(n)) return p;
+        return ::operator new(n);
+    }
+
+    static void operator delete(void* p, std::size_t n) noexcept {
+        if (!size_class::deallocate(p, n)) ::operator delete(p, n);
+    }
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(ALLOC_HAVE_LIBNUMA)
+#include <numa.h>
+#endif
+
+// Топология NUMA и память, привязанная к узлу.
+// libnuma используется, если проект собран с ALLOC_HAVE_LIBNUMA (цель alloc::numa),
+// иначе на Linux - сырые syscalls (getcpu, mbind), на остальных ОС - один узел.
+// ALLOC_NUMA_SIMULATE=<k> или numa::simulate(k) - k виртуальных узлов для отладки
+// и бенчмарков на одноузловой машине: потоки раздаются узлам по кругу, привязки нет.
+namespace numa {
+
+constexpr int kMaxNodes = 16;
+
+namespace detail {
+
+struct Topology {
+    int  nodes     = 1;
+    bool simulated = false;
+};
+
+inline std::atomic<int> simulate_request{0};
+inline std::atomic<std::size_t> bind_failures{0};
+
+inline int detect_nodes() noexcept {
+#if defined(ALLOC_HAVE_LIBNUMA)
+    if (numa_available() >= 0) return numa_max_node() + 1;
+    return 1;
+#elif defined(__linux__)
+    // формат "0" или "0-3"
+    int last = 0;
+    if (std::FILE* f = std::fopen("/sys/devices/system/node/online", "r")) {
+        int first = 0;
+        int n = std::fscanf(f, "%d-%d", &first, &last);
+        if (n < 2) last = first;
+        std::fclose(f);
+    }
+    return last + 1;
+#else
+    return 1;
+#endif
+}
+
+inline const Topology& topology() noexcept {
+    static const Topology topo = [] {
+        Topology t;
+        int sim = simulate_request.load();
+        if (!sim) {
+            if (const char* env = std::getenv("ALLOC_NUMA_SIMULATE")) sim = std::atoi(env);
+        }
+        if (sim > 0) {
+            t.nodes = sim;
+            t.simulated = true;
+        } else {
+            t.nodes = detect_nodes();
+        }
+        if (t.nodes > kMaxNodes) t.nodes = kMaxNodes;
+        if (t.nodes < 1) t.nodes = 1;
+        return t;
+    }();
+    return topo;
+}
+
+inline int query_current_node() noexcept {
+    const Topology& t = topology();
+    if (t.simulated) {
+        static std::atomic<int> next{0};
+        return next.fetch_add(1, std::memory_order_relaxed) % t.nodes;
+    }
+#if defined(ALLOC_HAVE_LIBNUMA)
+    int node = numa_node_of_cpu(sched_getcpu());
+    return node < 0 ? 0 : node % t.nodes;
+#elif defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return 0;
+    return static_cast<int>(node) % t.nodes;
+#else
+    return 0;
+#endif
+}
+
+} // namespace detail
+
+// Включить симуляцию k узлов; действует только до первого обращения к топологии.
+inline void simulate(int k) noexcept { detail::simulate_request.store(k); }
+
+inline int  node_count() noexcept { return detail::topology().nodes; }
+inline bool simulated() noexcept { return detail::topology().simulated; }
+
+// Сколько раз mbind отказал: такая память размещается по first-touch, а не на узле.
+inline std::size_t bind_failures() noexcept { return detail::bind_failures.load(std::memory_order_relaxed); }
+
+// Узел текущего потока; определяется один раз на поток (потоки стоит закреплять за CPU).
+inline int current_node() noexcept {
+    thread_local int node = detail::query_current_node();
+    return node;
+}
+
+// bytes памяти, физически размещаемой на узле node (страницы выделяются при первом касании).
+// mmap и libnuma выдают целые страницы, так что align до размера страницы соблюдается сам.
+// node вне [0, kMaxNodes) - std::invalid_argument.
+inline void* alloc_on_node(std::size_t bytes, int node, std::size_t align = alignof(std::max_align_t)) {
+    if (node < 0 || node >= kMaxNodes) throw std::invalid_argument("numa::alloc_on_node: node out of range");
+    void* p = nullptr;
+#if defined(ALLOC_HAVE_LIBNUMA)
+    if (!simulated() && numa_available() >= 0) {
+        p = numa_alloc_onnode(bytes, node);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+#endif
+#if defined(__linux__)
+    p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+#if defined(SYS_mbind)
+    if (!simulated() && node_count() > 1) {
+        // MPOL_PREFERRED: при нехватке памяти на узле ядро возьмёт соседний
+        constexpr int kMpolPreferred = 1;
+        constexpr int kBits = int(sizeof(unsigned long) * 8);
+        unsigned long mask[(kMaxNodes + kBits - 1) / kBits] = {};
+        mask[node / kBits] |= 1ul << (node % kBits);
+        // ядро читает maxnode - 1 бит маски, отсюда +1
+        if (::syscall(SYS_mbind, p, bytes, kMpolPreferred, mask, (unsigned long)kMaxNodes + 1, 0) != 0)
+            detail::bind_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+    (void)align;
+    return p;
+#else
+    (void)node;
+    return ::operator new(bytes, std::align_val_t(align));
+#endif
+}
+
+// align - тот же, что при alloc_on_node
+inline void free_on_node(void* p, std::size_t bytes, std::size_t align = alignof(std::max_align_t)) noexcept {
+#if defined(ALLOC_HAVE_LIBNUMA)
+    if (!simulated() && numa_available() >= 0) {
+        numa_free(p, bytes);
+        return;
+    }
+#endif
+#if defined(__linux__)
+    (void)align;
+    ::munmap(p, bytes);
+#else
+    (void)bytes;
+    ::operator delete(p, std::align_val_t(align));
+#endif
+}
+
+} // namespace numa
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#include "alloc/numa.hpp"
+#include "alloc/static_pool_allocator.hpp"
+
+// NUMA-aware пул: у каждого узла свой слаб на N ячеек, размещённый на этом узле.
+// Поток берёт ячейки из слаба своего узла (при исчерпании - у соседних),
+// освобождённая ячейка возвращается в слаб, которому принадлежит.
+// В отличие от StaticPoolAllocator потокобезопасен: у каждого узла свой мьютекс.
+template <class T, std::size_t N>
+class NumaPoolAllocator {
+public:
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type; // у каждого T свой набор пулов
+
+    template <class U> struct rebind { using other = NumaPoolAllocator<U, N>; };
+
+    NumaPoolAllocator() noexcept = default;
+    template <class U>
+    NumaPoolAllocator(const NumaPoolAllocator<U, N>&) noexcept {}
+
+    pointer allocate(size_type n) {
+        if (n == 0) return nullptr;
+        if (n != 1) throw std::bad_alloc();
+
+        const int nodes = numa::node_count();
+        const int home  = numa::current_node();
+        for (int k = 0; k < nodes; ++k) {
+            const int node = (home + k) % nodes;
+            if (void* p = pools_[node].pop(node)) return static_cast<pointer>(p);
+        }
+        throw std::bad_alloc();
+    }
+
+    void deallocate(pointer p, size_type) noexcept {
+        if (!p || ALLOC_UNLIKELY(pool_fast_exit_enabled())) return;
+        pools_[node_of(p)].push(p);
+    }
+
+    // узел, чьему слабу принадлежит p
+    static int node_of(const T* p) noexcept {
+        const int nodes = numa::node_count();
+        for (int i = 0; i < nodes; ++i)
+            if (pools_[i].owns(p)) return i;
+        return 0;
+    }
+
+    static size_type live_on(int node) noexcept {
+        std::lock_guard<std::mutex> lock(pools_[node].mutex);
+        return pools_[node].live;
+    }
+
+    static constexpr size_type capacity_per_node() noexcept { return N; }
+
+    // отказы mbind при размещении слабов (общий счётчик numa::bind_failures)
+    static std::size_t bind_failures() noexcept { return numa::bind_failures(); }
+
+    template <class U>
+    bool operator==(const NumaPoolAllocator<U, N>&) const noexcept { return std::is_same_v<T, U>; }
+    template <class U>
+    bool operator!=(const NumaPoolAllocator<U, N>& other) const noexcept { return !(*this == other); }
+
+private:
+    struct FreeNode { FreeNode* next; };
+
+    using storage_t = std::aligned_storage_t<
+        (sizeof(T) > sizeof(FreeNode) ? sizeof(T) : sizeof(FreeNode)),
+        (alignof(T) > alignof(FreeNode) ? alignof(T) : alignof(FreeNode))>;
+
+    static constexpr std::size_t kSlabBytes = sizeof(storage_t) * N;
+
+    struct NodePool {
+        std::mutex              mutex;
+        std::atomic<storage_t*> slab{nullptr}; // пишется один раз под мьютексом
+        std::size_t             used      = 0;
+        std::size_t             live      = 0;
+        FreeNode*               free_list = nullptr;
+
+        void* pop(int node) {
+            std::lock_guard<std::mutex> lock(mutex);
+            storage_t* s = slab.load(std::memory_order_relaxed);
+            if (!s) {
+                (void)&reaper_;
+                s = static_cast<storage_t*>(numa::alloc_on_node(kSlabBytes, node, alignof(storage_t)));
+                slab.store(s, std::memory_order_release);
+            }
+            void* p = nullptr;
+            if (free_list) {
+                p = free_list;
+                free_list = free_list->next;
+            } else if (used < N) {
+                p = &s[used++];
+            } else {
+                return nullptr;
+            }
+            ++live;
+            return p;
+        }
+
+        void push(void* p) noexcept {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto f = static_cast<FreeNode*>(p);
+            f->next = free_list;
+            free_list = f;
+            --live;
+        }
+
+        bool owns(const void* p) const noexcept {
+            auto s = reinterpret_cast<const unsigned char*>(slab.load(std::memory_order_acquire));
+            auto a = static_cast<const unsigned char*>(p);
+            return s && a >= s && a < s + kSlabBytes;
+        }
+    };
+
+    // как и у StaticPoolAllocator: без деструктора, слабы освобождает Reaper,
+    // только если к выходу все они пусты
+    static inline NodePool pools_[numa::kMaxNodes]{};
+
+    struct Reaper {
+        ~Reaper() {
+            if (ALLOC_POOL_IMMORTAL) return;
+            for (auto& np : pools_)
+                if (np.live != 0) return;
+            for (auto& np : pools_) {
+                if (storage_t* s = np.slab.exchange(nullptr)) numa::free_on_node(s, kSlabBytes, alignof(storage_t));
+                np.used = 0;
+                np.free_list = nullptr;
+            }
+        }
+    };
+    static inline Reaper reaper_{};
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "alloc/simple_forward_list.hpp"
+#include "alloc/task_scheduler.hpp"
+
+// Параллельные операции над контейнерами поверх TaskScheduler.
+// Куски должны быть достаточно крупными: задача стоит порядка сотни наносекунд.
+namespace parallel {
+
+// сколько кусков давать на поток, чтобы было что красть при неравномерной нагрузке
+inline constexpr std::size_t kChunksPerThread = 4;
+
+inline std::size_t chunk_count(std::size_t n, std::size_t grain, TaskScheduler& s) {
+    if (grain == 0) grain = 1;
+    std::size_t by_grain = (n + grain - 1) / grain;
+    std::size_t by_threads = (s.thread_count() + 1) * kChunksPerThread;
+    return std::max<std::size_t>(1, std::min(by_grain, by_threads));
+}
+
+// fn(first, last) на непересекающихся поддиапазонах [first, last)
+template <class Index, class Fn>
+void parallel_for(Index first, Index last, std::size_t grain, Fn fn,
+                  TaskScheduler& s = TaskScheduler::instance()) {
+    if (!(first < last)) return;
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    const std::size_t parts = chunk_count(n, grain, s);
+    if (parts == 1) { fn(first, last); return; }
+    TaskGroup g(s);
+    for (std::size_t i = 1; i < parts; ++i) {
+        Index b = first + static_cast<Index>(n * i / parts);
+        Index e = first + static_cast<Index>(n * (i + 1) / parts);
+        g.run([&fn, b, e] { fn(b, e); });
+    }
+    fn(first, first + static_cast<Index>(n / parts));
+    g.wait();
+}
+
+// Произвольные forward-итераторы (std::map и т.п.): границы кусков находятся
+// одним последовательным проходом, тело fn выполняется параллельно.
+template <class It, class Fn>
+void parallel_for_each(It first, It last, Fn fn, std::size_t grain = 1024,
+                       TaskScheduler& s = TaskScheduler::instance()) {
+    const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+    if (n == 0) return;
+    const std::size_t parts = chunk_count(n, grain, s);
+    std::vector<It> bounds;
+    bounds.reserve(parts + 1);
+    It it = first;
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < parts; ++i) {
+        std::size_t target = n * i / parts;
+        std::advance(it, static_cast<std::ptrdiff_t>(target - pos));
+        pos = target;
+        bounds.push_back(it);
+    }
+    bounds.push_back(last);
+
+    TaskGroup g(s);
+    for (std::size_t i = 1; i < parts; ++i)
+        g.run([&fn, b = bounds[i], e = bounds[i + 1]] { for (It p = b; p != e; ++p) fn(*p); });
+    for (It p = bounds[0]; p != bounds[1]; ++p) fn(*p);
+    g.wait();
+}
+
+// Для списка границы берутся из split(): с построенным индексом это O(parts * stride).
+// Без индекса поиск границ - лишний проход по ссылкам, сравнимый по цене с самим
+// обходом, поэтому такой список (и список на один кусок) обходится последовательно.
+template <class T, class A, std::size_t K, class Fn>
+void parallel_for_each(SimpleForwardList<T, A, K>& list, Fn fn, std::size_t grain = 1024,
+                       TaskScheduler& s = TaskScheduler::instance()) {
+    using It = typename SimpleForwardList<T, A, K>::iterator;
+    if (list.empty()) return;
+    const std::size_t parts = chunk_count(list.size(), grain, s);
+    if (parts == 1 || !list.has_index()) {
+        for (auto& v : list) fn(v);
+        return;
+    }
+    std::vector<It> bounds = list.split(parts);
+
+    TaskGroup g(s);
+    for (std::size_t i = 1; i < parts; ++i)
+        g.run([&fn, b = bounds[i], e = bounds[i + 1]] { for (It p = b; p != e; ++p) fn(*p); });
+    for (It p = bounds[0]; p != bounds[1]; ++p) fn(*p);
+    g.wait();
+}
+
+namespace detail {
+
+template <bool Stable, class It, class Cmp>
+void sort_rec(It first, It last, Cmp& cmp, std::size_t cutoff, TaskScheduler& s) {
+    const auto n = static_cast<std::size_t>(last - first);
+    if (n <= cutoff) {
+        if constexpr (Stable) std::stable_sort(first, last, cmp);
+        else std::sort(first, last, cmp);
+        return;
+    }
+    It mid = first + static_cast<std::ptrdiff_t>(n / 2);
+    TaskGroup g(s);
+    g.run([&] { sort_rec<Stable>(first, mid, cmp, cutoff, s); });
+    sort_rec<Stable>(mid, last, cmp, cutoff, s);
+    g.wait();
+    std::inplace_merge(first, mid, last, cmp);
+}
+
+inline std::size_t sort_cutoff(std::size_t n, TaskScheduler& s) {
+    const std::size_t leaves = s.thread_count() * kChunksPerThread;
+    return std::max<std::size_t>(4096, n / std::max<std::size_t>(1, leaves));
+}
+
+} // namespace detail
+
+// Сортировка слиянием: половины сортируются параллельно, листья - std::sort.
+template <class It, class Cmp = std::less<>>
+void parallel_sort(It first, It last, Cmp cmp = {}, TaskScheduler& s = TaskScheduler::instance()) {
+    const auto n = static_cast<std::size_t>(last - first);
+    detail::sort_rec<false>(first, last, cmp, detail::sort_cutoff(n, s), s);
+}
+
+// То же, но равные элементы сохраняют исходный порядок (inplace_merge стабилен).
+template <class It, class Cmp = std::less<>>
+void parallel_stable_sort(It first, It last, Cmp cmp = {}, TaskScheduler& s = TaskScheduler::instance()) {
+    const auto n = static_cast<std::size_t>(last - first);
+    detail::sort_rec<true>(first, last, cmp, detail::sort_cutoff(n, s), s);
+}
+
+// ниже этого размера bulk_load сортирует в вызывающем потоке и не трогает планировщик
+inline constexpr std::size_t kBulkLoadSequential = 1u << 14;
+
+// Массовая загрузка упорядоченного контейнера (std::map/std::set с пулом и т.п.)
+// из неотсортированных пар ключ-значение. Вход сортируется параллельно и
+// вставляется по возрастанию с подсказкой end(): каждая вставка - амортизированно
+// O(1) без спуска по дереву, а узлы берутся из пула подряд, в порядке обхода.
+// Из повторяющихся ключей остаётся первый по входу - как при поэлементном emplace.
+template <class Map, class It>
+void bulk_load(Map& m, It first, It last, TaskScheduler* s = nullptr) {
+    using Key   = typename Map::key_type;
+    using Value = std::pair<Key, typename Map::mapped_type>;
+    std::vector<Value> items(first, last);
+    if (items.empty()) return;
+
+    auto kc = m.key_comp();
+    auto less = [&kc](const Value& a, const Value& b) { return kc(a.first, b.first); };
+    if (items.size() < kBulkLoadSequential) {
+        std::stable_sort(items.begin(), items.end(), less);
+    } else {
+        parallel_stable_sort(items.begin(), items.end(), less, s ? *s : TaskScheduler::instance());
+    }
+    auto dup = [&kc](const Value& a, const Value& b) { return !kc(a.first, b.first); };
+    items.erase(std::unique(items.begin(), items.end(), dup), items.end());
+
+    // в непустой контейнер подсказка end() верна не всегда - тогда emplace_hint
+    // сам откатывается к обычному поиску
+    for (auto& kv : items) m.emplace_hint(m.end(), std::move(kv.first), std::move(kv.second));
+}
+
+} // namespace parallel
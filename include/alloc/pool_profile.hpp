@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+// Профиль пулов: пиковое число живых ячеек каждого пула по имени его типа.
+// Если задан ALLOC_POOL_PROFILE=<файл>, профиль читается при первом запросе
+// подсказки и записывается при завершении процесса (максимум из прочитанного
+// и увиденного за этот запуск). Так подбор ёмкости пулов делает сам прогон.
+namespace pool_profile {
+
+inline constexpr const char* kEnvVar = "ALLOC_POOL_PROFILE";
+
+// имя типа из сигнатуры функции; стабильно между запусками одной сборки
+template <class T>
+std::string_view type_name() noexcept {
+#if defined(__clang__) || defined(__GNUC__)
+    std::string_view s = __PRETTY_FUNCTION__;
+    const std::string_view key = "T = ";
+    auto b = s.find(key);
+    if (b == std::string_view::npos) return s;
+    b += key.size();
+    auto e = s.find_first_of(";]", b);
+    return s.substr(b, e - b);
+#elif defined(_MSC_VER)
+    std::string_view s = __FUNCSIG__;
+    auto b = s.find("type_name<");
+    auto e = s.rfind(">(void)");
+    if (b == std::string_view::npos || e == std::string_view::npos) return s;
+    b += 10;
+    return s.substr(b, e - b);
+#else
+    return typeid(T).name();
+#endif
+}
+
+namespace detail {
+
+using PeakFn = std::size_t (*)() noexcept;
+
+struct Entry {
+    std::string_view name;
+    PeakFn           peak;
+};
+
+// Реестр пулов - массив с константной инициализацией и без деструктора:
+// record() зовётся из нарезки слаба, где нельзя ни выделять память (пул может
+// обслуживать сам operator new), ни полагаться на порядок статической деструкции.
+inline constexpr std::size_t kMaxPools = 512;
+inline Entry       g_pools[kMaxPools];
+inline std::size_t g_pool_count = 0;
+inline std::mutex  g_pools_mutex; // под ним память не выделяется
+
+// Прочитанный профиль; создаётся при первом чтении и намеренно не освобождается.
+// Свой mutex: выделение памяти под ним может дойти до record() нового пула.
+inline std::mutex g_loaded_mutex;
+using Loaded = std::vector<std::pair<std::string, std::size_t>>;
+inline Loaded* g_loaded = nullptr;
+inline bool    g_env_loaded = false;
+
+inline Loaded& loaded_locked() {
+    if (!g_loaded) g_loaded = new Loaded;
+    return *g_loaded;
+}
+
+inline bool load_locked(const char* path) {
+    std::FILE* f = std::fopen(path, "r");
+    if (!f) return false;
+    Loaded& l = loaded_locked();
+    char line[1024];
+    while (std::fgets(line, sizeof(line), f)) {
+        char* end = nullptr;
+        unsigned long long peak = std::strtoull(line, &end, 10);
+        if (end == line || *end != ' ') continue;
+        std::string name(end + 1);
+        while (!name.empty() && (name.back() == '\n' || name.back() == '\r')) name.pop_back();
+        auto it = std::find_if(l.begin(), l.end(), [&](const auto& e) { return e.first == name; });
+        if (it == l.end()) l.emplace_back(std::move(name), std::size_t(peak));
+        else it->second = std::max(it->second, std::size_t(peak));
+    }
+    std::fclose(f);
+    return true;
+}
+
+inline void ensure_env_loaded_locked() {
+    if (g_env_loaded) return;
+    g_env_loaded = true;
+    if (const char* path = std::getenv(kEnvVar)) load_locked(path);
+}
+
+} // namespace detail
+
+// Регистрирует пул (повторная регистрация того же имени игнорируется). Не выделяет память.
+inline void record(std::string_view name, detail::PeakFn peak) noexcept {
+    std::lock_guard<std::mutex> lock(detail::g_pools_mutex);
+    for (std::size_t i = 0; i < detail::g_pool_count; ++i)
+        if (detail::g_pools[i].name == name) return;
+    if (detail::g_pool_count < detail::kMaxPools) detail::g_pools[detail::g_pool_count++] = {name, peak};
+}
+
+// пик пула из профиля или 0, если его там нет
+inline std::size_t hint(std::string_view name) {
+    std::lock_guard<std::mutex> lock(detail::g_loaded_mutex);
+    detail::ensure_env_loaded_locked();
+    if (!detail::g_loaded) return 0;
+    for (const auto& e : *detail::g_loaded)
+        if (e.first == name) return e.second;
+    return 0;
+}
+
+inline bool load(const char* path) {
+    std::lock_guard<std::mutex> lock(detail::g_loaded_mutex);
+    return detail::load_locked(path);
+}
+
+// строки "<пик> <имя типа пула>"; пулы из профиля, не встреченные в этом запуске, сохраняются
+inline bool save(const char* path) {
+    detail::Loaded out;
+    {
+        std::lock_guard<std::mutex> lock(detail::g_loaded_mutex);
+        detail::ensure_env_loaded_locked();
+        out = detail::loaded_locked();
+    }
+    // записи реестра только дописываются: первые count уже неизменны
+    std::size_t count;
+    {
+        std::lock_guard<std::mutex> lock(detail::g_pools_mutex);
+        count = detail::g_pool_count;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& e = detail::g_pools[i];
+        auto it = std::find_if(out.begin(), out.end(), [&](const auto& o) { return o.first == e.name; });
+        if (it == out.end()) out.emplace_back(std::string(e.name), e.peak());
+        else it->second = std::max(it->second, e.peak());
+    }
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) return false;
+    for (const auto& [name, peak] : out) std::fprintf(f, "%zu %s\n", peak, name.c_str());
+    return std::fclose(f) == 0;
+}
+
+namespace detail {
+
+// запись профиля при выходе, если задана переменная окружения
+struct Saver {
+    ~Saver() {
+        if (const char* path = std::getenv(kEnvVar)) save(path);
+    }
+};
+inline Saver saver_{};
+
+} // namespace detail
+
+} // namespace pool_profile
@@ -0,0 +1,567 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "alloc/adaptive_pool_allocator.hpp"
+#include "alloc/simd/kernels.hpp"
+#include "alloc/simd/search.hpp"
+
+// Адаптивное radix-дерево (ART) для целых ключей 8..64 бит: ключ разбирается
+// побайтно от старшего, внутренние узлы - Node4/16/48/256 по числу детей,
+// каждый размер в своём AdaptivePoolAllocator. Общие части пути хранятся в узле
+// (сжатие путей), лист создаётся сразу под первым отличающимся байтом
+// (ленивое раскрытие) и держит ключ целиком. Поиск в Node16 - SIMD-сравнение
+// 16 байт. Обход - по возрастанию ключа. Как и пулы - однопоточное.
+template <class Key, class Value>
+class RadixTreeMap {
+    static_assert(std::is_integral_v<Key> && !std::is_same_v<Key, bool>, "RadixTreeMap: ключ - целое");
+
+    using U = std::make_unsigned_t<Key>;
+    static constexpr unsigned kBytes = sizeof(Key);
+    // знаковые ключи: инверсия старшего бита сохраняет порядок при побайтном сравнении
+    static constexpr U kFlip = std::is_signed_v<Key> ? U(U(1) << (8 * kBytes - 1)) : U(0);
+
+    enum : std::uint8_t { kNode4, kNode16, kNode48, kNode256 };
+
+    // выравнивание >= 2: младший бит указателя на лист занят тегом
+    struct alignas(2) Leaf {
+        U     key;
+        Value value;
+    };
+
+    // ссылка на ребёнка: младший бит 1 - лист
+    using Ref = std::uintptr_t;
+
+    struct Header {
+        std::uint8_t  type;
+        std::uint8_t  prefix_len = 0;
+        std::uint16_t count = 0;
+        std::uint8_t  prefix[kBytes] = {}; // ключ не длиннее kBytes, поэтому префикс целиком
+    };
+
+    struct Node4 : Header {
+        std::uint8_t keys[4] = {};  // по возрастанию
+        Ref          children[4];
+        Node4() { this->type = kNode4; }
+    };
+
+    struct Node16 : Header {
+        std::uint8_t keys[16] = {}; // по возрастанию; читаются SIMD целиком
+        Ref          children[16];
+        Node16() { this->type = kNode16; }
+    };
+
+    struct Node48 : Header {
+        std::uint8_t index[256] = {}; // 0 - нет ребёнка, иначе номер в children + 1
+        Ref          children[48] = {};
+        Node48() { this->type = kNode48; }
+    };
+
+    struct Node256 : Header {
+        Ref children[256] = {};
+        Node256() { this->type = kNode256; }
+    };
+
+public:
+    using key_type    = Key;
+    using mapped_type = Value;
+
+    RadixTreeMap() = default;
+    ~RadixTreeMap() { clear(); }
+
+    RadixTreeMap(const RadixTreeMap&) = delete;
+    RadixTreeMap& operator=(const RadixTreeMap&) = delete;
+
+    RadixTreeMap(RadixTreeMap&& r) noexcept
+        : root_(std::exchange(r.root_, 0)), sz_(std::exchange(r.sz_, 0)) {}
+
+    RadixTreeMap& operator=(RadixTreeMap&& r) noexcept {
+        if (this != &r) {
+            clear();
+            root_ = std::exchange(r.root_, 0);
+            sz_ = std::exchange(r.sz_, 0);
+        }
+        return *this;
+    }
+
+    // false - ключ уже есть (значение не меняется)
+    bool insert(Key key, const Value& value) { return insert_(root_, to_u_(key), 0, value, false); }
+    // вставка или замена значения; true - ключа не было
+    bool insert_or_assign(Key key, const Value& value) { return insert_(root_, to_u_(key), 0, value, true); }
+
+    Value* find(Key key) noexcept {
+        const U u = to_u_(key);
+        Ref r = root_;
+        for (unsigned depth = 0; r; ++depth) {
+            if (is_leaf_(r)) {
+                Leaf* l = leaf_(r);
+                return l->key == u ? &l->value : nullptr;
+            }
+            const Header* h = node_(r);
+            for (unsigned i = 0; i < h->prefix_len; ++i)
+                if (h->prefix[i] != byte_(u, depth + i)) return nullptr;
+            depth += h->prefix_len;
+            const Ref* c = child_(r, byte_(u, depth));
+            if (!c) return nullptr;
+            r = *c;
+        }
+        return nullptr;
+    }
+
+    const Value* find(Key key) const noexcept { return const_cast<RadixTreeMap*>(this)->find(key); }
+
+    bool contains(Key key) const noexcept { return find(key) != nullptr; }
+
+    bool erase(Key key) {
+        if (!erase_(root_, to_u_(key), 0)) return false;
+        --sz_;
+        return true;
+    }
+
+    // fn(key, value) по возрастанию ключа
+    template <class Fn>
+    void for_each(Fn&& fn) const {
+        if (root_) for_each_(root_, fn);
+    }
+
+    void clear() noexcept {
+        // при быстром выходе узлы не обходим: пулы всё равно не освобождаются
+        if (std::is_trivially_destructible_v<Value> && pool_fast_exit_enabled()) {
+            root_ = 0;
+            sz_ = 0;
+            return;
+        }
+        if (root_) destroy_(root_);
+        root_ = 0;
+        sz_ = 0;
+    }
+
+    bool empty() const noexcept { return sz_ == 0; }
+    std::size_t size() const noexcept { return sz_; }
+
+private:
+    static U to_u_(Key k) noexcept { return U(U(k) ^ kFlip); }
+    static Key from_u_(U u) noexcept { return Key(U(u ^ kFlip)); }
+
+    static std::uint8_t byte_(U u, unsigned depth) noexcept {
+        return static_cast<std::uint8_t>(u >> (8 * (kBytes - 1 - depth)));
+    }
+
+    static bool is_leaf_(Ref r) noexcept { return r & 1; }
+    static Leaf* leaf_(Ref r) noexcept { return reinterpret_cast<Leaf*>(r & ~Ref(1)); }
+    static Header* node_(Ref r) noexcept { return reinterpret_cast<Header*>(r); }
+    static Ref leaf_ref_(Leaf* l) noexcept { return reinterpret_cast<Ref>(l) | 1; }
+    static Ref node_ref_(Header* h) noexcept { return reinterpret_cast<Ref>(h); }
+
+    template <class T, class... Args>
+    static T* make_(Args&&... args) {
+        AdaptivePoolAllocator<T> a;
+        T* p = a.allocate(1);
+        try {
+            ::new (static_cast<void*>(p)) T{std::forward<Args>(args)...};
+        } catch (...) {
+            a.deallocate(p, 1);
+            throw;
+        }
+        return p;
+    }
+
+    template <class T>
+    static void free_(T* p) noexcept {
+        p->~T();
+        AdaptivePoolAllocator<T>().deallocate(p, 1);
+    }
+
+    static void free_node_(Header* h) noexcept {
+        switch (h->type) {
+            case kNode4:  free_(static_cast<Node4*>(h)); break;
+            case kNode16: free_(static_cast<Node16*>(h)); break;
+            case kNode48: free_(static_cast<Node48*>(h)); break;
+            default:      free_(static_cast<Node256*>(h)); break;
+        }
+    }
+
+    // ячейка ребёнка по байту, nullptr - нет
+    static Ref* child_(Ref r, std::uint8_t b) noexcept {
+        Header* h = node_(r);
+        switch (h->type) {
+            case kNode4: {
+                auto* n = static_cast<Node4*>(h);
+                for (unsigned i = 0; i < n->count; ++i)
+                    if (n->keys[i] == b) return &n->children[i];
+                return nullptr;
+            }
+            case kNode16: {
+                auto* n = static_cast<Node16*>(h);
+                const unsigned i = simd::find_byte16(n->keys, n->count, b);
+                return i < n->count ? &n->children[i] : nullptr;
+            }
+            case kNode48: {
+                auto* n = static_cast<Node48*>(h);
+                return n->index[b] ? &n->children[n->index[b] - 1] : nullptr;
+            }
+            default: {
+                auto* n = static_cast<Node256*>(h);
+                return n->children[b] ? &n->children[b] : nullptr;
+            }
+        }
+    }
+
+    // вставка в отсортированные keys/children длины count
+    template <class N>
+    static void insert_sorted_(N* n, std::uint8_t b, Ref child) noexcept {
+        unsigned pos = 0;
+        if constexpr (sizeof(n->keys) == 16) {
+            pos = simd::lower_bound_byte16(n->keys, n->count, b);
+        } else {
+            while (pos < n->count && n->keys[pos] < b) ++pos;
+        }
+        std::memmove(n->keys + pos + 1, n->keys + pos, n->count - pos);
+        std::memmove(n->children + pos + 1, n->children + pos, (n->count - pos) * sizeof(Ref));
+        n->keys[pos] = b;
+        n->children[pos] = child;
+        ++n->count;
+    }
+
+    static void copy_header_(Header* to, const Header* from) noexcept {
+        to->prefix_len = from->prefix_len;
+        to->count = from->count;
+        std::memcpy(to->prefix, from->prefix, kBytes);
+    }
+
+    // добавляет ребёнка; полный узел заменяется следующим по размеру (ref обновляется)
+    static void add_child_(Ref& ref, std::uint8_t b, Ref child) {
+        Header* h = node_(ref);
+        switch (h->type) {
+            case kNode4: {
+                auto* n = static_cast<Node4*>(h);
+                if (n->count < 4) return insert_sorted_(n, b, child);
+                auto* g = make_<Node16>();
+                copy_header_(g, n);
+                std::memcpy(g->keys, n->keys, 4);
+                std::memcpy(g->children, n->children, 4 * sizeof(Ref));
+                free_(n);
+                ref = node_ref_(g);
+                return insert_sorted_(g, b, child);
+            }
+            case kNode16: {
+                auto* n = static_cast<Node16*>(h);
+                if (n->count < 16) return insert_sorted_(n, b, child);
+                auto* g = make_<Node48>();
+                copy_header_(g, n);
+                for (unsigned i = 0; i < 16; ++i) {
+                    g->children[i] = n->children[i];
+                    g->index[n->keys[i]] = static_cast<std::uint8_t>(i + 1);
+                }
+                free_(n);
+                ref = node_ref_(g);
+                return add_child_(ref, b, child);
+            }
+            case kNode48: {
+                auto* n = static_cast<Node48*>(h);
+                if (n->count < 48) {
+                    unsigned slot = 0;
+                    while (n->children[slot]) ++slot;
+                    n->children[slot] = child;
+                    n->index[b] = static_cast<std::uint8_t>(slot + 1);
+                    ++n->count;
+                    return;
+                }
+                auto* g = make_<Node256>();
+                copy_header_(g, n);
+                for (unsigned k = 0; k < 256; ++k)
+                    if (n->index[k]) g->children[k] = n->children[n->index[k] - 1];
+                free_(n);
+                ref = node_ref_(g);
+                return add_child_(ref, b, child);
+            }
+            default: {
+                auto* n = static_cast<Node256*>(h);
+                n->children[b] = child;
+                ++n->count;
+                return;
+            }
+        }
+    }
+
+    bool insert_(Ref& ref, U u, unsigned depth, const Value& value, bool assign) {
+        if (!ref) {
+            ref = leaf_ref_(make_<Leaf>(u, value));
+            ++sz_;
+            return true;
+        }
+        if (is_leaf_(ref)) {
+            Leaf* l = leaf_(ref);
+            if (l->key == u) {
+                if (assign) l->value = value;
+                return false;
+            }
+            // новый узел с общей частью двух ключей в префиксе
+            Leaf* nl = make_<Leaf>(u, value);
+            Node4* n;
+            try {
+                n = make_<Node4>();
+            } catch (...) {
+                free_(nl);
+                throw;
+            }
+            unsigned lcp = 0;
+            while (byte_(l->key, depth + lcp) == byte_(u, depth + lcp)) {
+                n->prefix[lcp] = byte_(u, depth + lcp);
+                ++lcp;
+            }
+            n->prefix_len = static_cast<std::uint8_t>(lcp);
+            insert_sorted_(n, byte_(l->key, depth + lcp), ref);
+            insert_sorted_(n, byte_(u, depth + lcp), leaf_ref_(nl));
+            ref = node_ref_(n);
+            ++sz_;
+            return true;
+        }
+        Header* h = node_(ref);
+        unsigned p = 0;
+        while (p < h->prefix_len && h->prefix[p] == byte_(u, depth + p)) ++p;
+        if (p < h->prefix_len) {
+            // ключ расходится с префиксом: узел разрезается новым Node4
+            Leaf* nl = make_<Leaf>(u, value);
+            Node4* n;
+            try {
+                n = make_<Node4>();
+            } catch (...) {
+                free_(nl);
+                throw;
+            }
+            n->prefix_len = static_cast<std::uint8_t>(p);
+            std::memcpy(n->prefix, h->prefix, p);
+            const std::uint8_t old_byte = h->prefix[p];
+            h->prefix_len = static_cast<std::uint8_t>(h->prefix_len - p - 1);
+            std::memmove(h->prefix, h->prefix + p + 1, h->prefix_len);
+            insert_sorted_(n, old_byte, ref);
+            insert_sorted_(n, byte_(u, depth + p), leaf_ref_(nl));
+            ref = node_ref_(n);
+            ++sz_;
+            return true;
+        }
+        depth += h->prefix_len;
+        const std::uint8_t b = byte_(u, depth);
+        if (Ref* c = child_(ref, b)) return insert_(*c, u, depth + 1, value, assign);
+        Leaf* nl = make_<Leaf>(u, value);
+        try {
+            add_child_(ref, b, leaf_ref_(nl));
+        } catch (...) {
+            free_(nl);
+            throw;
+        }
+        ++sz_;
+        return true;
+    }
+
+    // снимает ребёнка с байтом b и при необходимости уменьшает узел
+    static void remove_child_(Ref& ref, std::uint8_t b) noexcept {
+        Header* h = node_(ref);
+        switch (h->type) {
+            case kNode4:
+            case kNode16: {
+                std::uint8_t* keys = h->type == kNode4 ? static_cast<Node4*>(h)->keys : static_cast<Node16*>(h)->keys;
+                Ref* children = h->type == kNode4 ? static_cast<Node4*>(h)->children : static_cast<Node16*>(h)->children;
+                unsigned pos = 0;
+                while (keys[pos] != b) ++pos;
+                std::memmove(keys + pos, keys + pos + 1, h->count - pos - 1);
+                std::memmove(children + pos, children + pos + 1, (h->count - pos - 1) * sizeof(Ref));
+                --h->count;
+                break;
+            }
+            case kNode48: {
+                auto* n = static_cast<Node48*>(h);
+                n->children[n->index[b] - 1] = 0;
+                n->index[b] = 0;
+                --n->count;
+                break;
+            }
+            default: {
+                auto* n = static_cast<Node256*>(h);
+                n->children[b] = 0;
+                --n->count;
+                break;
+            }
+        }
+        shrink_(ref);
+    }
+
+    // уменьшение с запасом против дребезга: 256 -> 48 при 37, 48 -> 16 при 12, 16 -> 4 при 3
+    static void shrink_(Ref& ref) noexcept {
+        Header* h = node_(ref);
+        switch (h->type) {
+            case kNode4: {
+                if (h->count != 1) return;
+                auto* n = static_cast<Node4*>(h);
+                Ref child = n->children[0];
+                if (!is_leaf_(child)) {
+                    // слияние путей: префикс узла + байт + префикс ребёнка (в сумме < kBytes)
+                    Header* c = node_(child);
+                    std::uint8_t merged[kBytes];
+                    unsigned len = n->prefix_len;
+                    std::memcpy(merged, n->prefix, len);
+                    merged[len++] = n->keys[0];
+                    std::memcpy(merged + len, c->prefix, c->prefix_len);
+                    len += c->prefix_len;
+                    std::memcpy(c->prefix, merged, len);
+                    c->prefix_len = static_cast<std::uint8_t>(len);
+                }
+                free_(n);
+                ref = child;
+                return;
+            }
+            case kNode16: {
+                if (h->count != 3) return;
+                auto* n = static_cast<Node16*>(h);
+                auto* s = shrink_alloc_<Node4>();
+                if (!s) return;
+                copy_header_(s, n);
+                std::memcpy(s->keys, n->keys, 3);
+                std::memcpy(s->children, n->children, 3 * sizeof(Ref));
+                free_(n);
+                ref = node_ref_(s);
+                return;
+            }
+            case kNode48: {
+                if (h->count != 12) return;
+                auto* n = static_cast<Node48*>(h);
+                auto* s = shrink_alloc_<Node16>();
+                if (!s) return;
+                copy_header_(s, n);
+                unsigned k = 0;
+                for (unsigned b = 0; b < 256; ++b) {
+                    if (!n->index[b]) continue;
+                    s->keys[k] = static_cast<std::uint8_t>(b);
+                    s->children[k++] = n->children[n->index[b] - 1];
+                }
+                free_(n);
+                ref = node_ref_(s);
+                return;
+            }
+            default: {
+                if (h->count != 37) return;
+                auto* n = static_cast<Node256*>(h);
+                auto* s = shrink_alloc_<Node48>();
+                if (!s) return;
+                copy_header_(s, n);
+                unsigned k = 0;
+                for (unsigned b = 0; b < 256; ++b) {
+                    if (!n->children[b]) continue;
+                    s->children[k] = n->children[b];
+                    s->index[b] = static_cast<std::uint8_t>(++k);
+                }
+                free_(n);
+                ref = node_ref_(s);
+                return;
+            }
+        }
+    }
+
+    // уменьшение необязательно: без памяти узел просто остаётся большим
+    template <class T>
+    static T* shrink_alloc_() noexcept {
+        try {
+            return make_<T>();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    bool erase_(Ref& ref, U u, unsigned depth) noexcept {
+        if (!ref) return false;
+        if (is_leaf_(ref)) {
+            // лист в корне
+            if (leaf_(ref)->key != u) return false;
+            free_(leaf_(ref));
+            ref = 0;
+            return true;
+        }
+        Header* h = node_(ref);
+        for (unsigned i = 0; i < h->prefix_len; ++i)
+            if (h->prefix[i] != byte_(u, depth + i)) return false;
+        depth += h->prefix_len;
+        const std::uint8_t b = byte_(u, depth);
+        Ref* c = child_(ref, b);
+        if (!c) return false;
+        if (!is_leaf_(*c)) return erase_(*c, u, depth + 1); // внутренний узел не пустеет: в нём >= 2 детей
+        if (leaf_(*c)->key != u) return false;
+        free_(leaf_(*c));
+        remove_child_(ref, b);
+        return true;
+    }
+
+    template <class Fn>
+    static void for_each_(Ref r, Fn& fn) {
+        if (is_leaf_(r)) {
+            Leaf* l = leaf_(r);
+            fn(from_u_(l->key), static_cast<const Value&>(l->value));
+            return;
+        }
+        Header* h = node_(r);
+        switch (h->type) {
+            case kNode4: {
+                auto* n = static_cast<Node4*>(h);
+                for (unsigned i = 0; i < n->count; ++i) for_each_(n->children[i], fn);
+                return;
+            }
+            case kNode16: {
+                auto* n = static_cast<Node16*>(h);
+                for (unsigned i = 0; i < n->count; ++i) for_each_(n->children[i], fn);
+                return;
+            }
+            case kNode48: {
+                auto* n = static_cast<Node48*>(h);
+                for (unsigned b = 0; b < 256; ++b)
+                    if (n->index[b]) for_each_(n->children[n->index[b] - 1], fn);
+                return;
+            }
+            default: {
+                auto* n = static_cast<Node256*>(h);
+                for (unsigned b = 0; b < 256; ++b)
+                    if (n->children[b]) for_each_(n->children[b], fn);
+                return;
+            }
+        }
+    }
+
+    static void destroy_(Ref r) noexcept {
+        if (is_leaf_(r)) {
+            free_(leaf_(r));
+            return;
+        }
+        Header* h = node_(r);
+        switch (h->type) {
+            case kNode4: {
+                auto* n = static_cast<Node4*>(h);
+                for (unsigned i = 0; i < n->count; ++i) destroy_(n->children[i]);
+                break;
+            }
+            case kNode16: {
+                auto* n = static_cast<Node16*>(h);
+                for (unsigned i = 0; i < n->count; ++i) destroy_(n->children[i]);
+                break;
+            }
+            case kNode48: {
+                auto* n = static_cast<Node48*>(h);
+                for (unsigned k = 0; k < 48; ++k)
+                    if (n->children[k]) destroy_(n->children[k]);
+                break;
+            }
+            default: {
+                auto* n = static_cast<Node256*>(h);
+                for (unsigned b = 0; b < 256; ++b)
+                    if (n->children[b]) destroy_(n->children[b]);
+                break;
+            }
+        }
+        free_node_(h);
+    }
+
+    Ref         root_ = 0;
+    std::size_t sz_ = 0;
+};
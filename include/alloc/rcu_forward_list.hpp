@@ -0,0 +1,210 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "alloc/epoch.hpp"
+#include "alloc/simple_forward_list.hpp"
+
+// Однонаправленный список в режиме RCU: читатели обходят его без блокировок
+// и ожидания (head_/next - атомики, чтение с acquire), писатели публикуют
+// готовые узлы release-записью и отдают снятые узлы в EBR. Читатель, стоящий
+// на снятом узле, дочитывает список по его next: снятый узел не меняется,
+// пока не освобождён.
+//
+// Писатели сериализуются внутренним mutex'ом (рассчитано на одного писателя и
+// много читателей). Узлы освобождаются отложенно, возможно уже после
+// разрушения списка, поэтому аллокатор - без состояния; вызовы его пула
+// идут под ebr::pool_mutex, общим с освобождением из EBR.
+template <class T, class Alloc = std::allocator<T>>
+class RcuForwardList {
+    struct Node {
+        T                  value;
+        std::atomic<Node*> next{nullptr};
+
+        template <class... Args>
+        Node(std::in_place_t, const Alloc& a, Args&&... args)
+            : value(detail::make_using_allocator<T>(a, std::forward<Args>(args)...)) {}
+    };
+
+    using NodeAlloc  = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    static_assert(std::is_empty_v<NodeAlloc> && std::is_default_constructible_v<NodeAlloc>,
+                  "RcuForwardList: узлы освобождаются без списка, нужен аллокатор без состояния");
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+
+    RcuForwardList() = default;
+    ~RcuForwardList() { clear(); }
+
+    RcuForwardList(const RcuForwardList&) = delete;
+    RcuForwardList& operator=(const RcuForwardList&) = delete;
+
+    // --- писатели ---
+
+    void push_back(const T& v) { emplace_back(v); }
+    void push_back(T&& v)      { emplace_back(std::move(v)); }
+
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        Node* n = make_node_(std::forward<Args>(args)...);
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        // узел построен целиком до публикации
+        if (tail_) tail_->next.store(n, std::memory_order_release);
+        else head_.store(n, std::memory_order_release);
+        tail_ = n;
+        sz_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <class... Args>
+    void emplace_front(Args&&... args) {
+        Node* n = make_node_(std::forward<Args>(args)...);
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        Node* h = head_.load(std::memory_order_relaxed);
+        n->next.store(h, std::memory_order_relaxed);
+        head_.store(n, std::memory_order_release);
+        if (!h) tail_ = n;
+        sz_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void push_front(const T& v) { emplace_front(v); }
+    void push_front(T&& v)      { emplace_front(std::move(v)); }
+
+    // false - список пуст
+    bool pop_front() {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        Node* h = head_.load(std::memory_order_relaxed);
+        if (!h) return false;
+        Node* next = h->next.load(std::memory_order_relaxed);
+        head_.store(next, std::memory_order_release);
+        if (!next) tail_ = nullptr;
+        sz_.fetch_sub(1, std::memory_order_relaxed);
+        ebr::retire_to_pool<NodeAlloc>(h);
+        return true;
+    }
+
+    // Снимает элементы, для которых pred(value) истинно; возвращает их число.
+    // Снятый узел сохраняет next, так что читатели на нём идут дальше.
+    template <class Pred>
+    std::size_t remove_if(Pred&& pred) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        std::size_t removed = 0;
+        Node* prev = nullptr;
+        Node* cur = head_.load(std::memory_order_relaxed);
+        while (cur) {
+            Node* next = cur->next.load(std::memory_order_relaxed);
+            if (pred(static_cast<const T&>(cur->value))) {
+                if (prev) prev->next.store(next, std::memory_order_release);
+                else head_.store(next, std::memory_order_release);
+                if (cur == tail_) tail_ = prev;
+                ebr::retire_to_pool<NodeAlloc>(cur);
+                ++removed;
+            } else {
+                prev = cur;
+            }
+            cur = next;
+        }
+        sz_.fetch_sub(removed, std::memory_order_relaxed);
+        return removed;
+    }
+
+    std::size_t remove(const T& v) { return remove_if([&](const T& x) { return x == v; }); }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        Node* cur = head_.exchange(nullptr, std::memory_order_acq_rel);
+        tail_ = nullptr;
+        sz_.store(0, std::memory_order_relaxed);
+        // при быстром выходе читателей уже нет, а узлы без деструкторов не обходим
+        if (std::is_trivially_destructible_v<T> && pool_fast_exit_enabled()) return;
+        while (cur) {
+            Node* next = cur->next.load(std::memory_order_relaxed);
+            ebr::retire_to_pool<NodeAlloc>(cur);
+            cur = next;
+        }
+    }
+
+    // --- читатели ---
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        explicit const_iterator(const Node* n) : p_(n) {}
+        reference operator*() const { return p_->value; }
+        pointer operator->() const { return &p_->value; }
+        const_iterator& operator++() { p_ = p_->next.load(std::memory_order_acquire); return *this; }
+        const_iterator operator++(int) { const_iterator tmp(*this); ++(*this); return tmp; }
+        bool operator==(const const_iterator& r) const { return p_ == r.p_; }
+        bool operator!=(const const_iterator& r) const { return p_ != r.p_; }
+
+    private:
+        const Node* p_ = nullptr;
+    };
+
+    // Обход под закреплённой эпохой: узлы, которые он может увидеть, не
+    // освобождаются, пока жив объект. Держать недолго - он задерживает
+    // освобождение узлов во всех EBR-структурах.
+    class ReadView {
+    public:
+        explicit ReadView(const RcuForwardList& l) : head_(l.head_.load(std::memory_order_acquire)) {}
+        const_iterator begin() const noexcept { return const_iterator(head_); }
+        const_iterator end() const noexcept { return const_iterator(); }
+
+    private:
+        ebr::Guard  guard_; // объявлен первым: эпоха закреплена до чтения head_
+        const Node* head_;
+    };
+
+    ReadView read() const { return ReadView(*this); }
+
+    template <class Fn>
+    void for_each(Fn&& fn) const {
+        ebr::Guard g;
+        for (const Node* n = head_.load(std::memory_order_acquire); n; n = n->next.load(std::memory_order_acquire))
+            fn(static_cast<const T&>(n->value));
+    }
+
+    // приблизительный размер при конкурентных изменениях
+    std::size_t size() const noexcept { return sz_.load(std::memory_order_relaxed); }
+    bool empty() const noexcept { return head_.load(std::memory_order_acquire) == nullptr; }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(); }
+
+private:
+    template <class... Args>
+    static Node* make_node_(Args&&... args) {
+        NodeAlloc a;
+        Node* n;
+        {
+            std::lock_guard<std::mutex> lock(ebr::pool_mutex<NodeAlloc>());
+            n = NodeTraits::allocate(a, 1);
+        }
+        try {
+            NodeTraits::construct(a, n, std::in_place, Alloc(), std::forward<Args>(args)...);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(ebr::pool_mutex<NodeAlloc>());
+            NodeTraits::deallocate(a, n, 1);
+            throw;
+        }
+        return n;
+    }
+
+    std::atomic<Node*>       head_{nullptr};
+    Node*                    tail_ = nullptr; // только под write_mutex_
+    std::atomic<std::size_t> sz_{0};
+    std::mutex               write_mutex_;
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "alloc/simd/reduce.hpp"
+
+// Свёртки над контейнерами библиотеки: sum / min / max / stats / count_if.
+// Контейнер разбирается на серии значений, лежащих в памяти с постоянным шагом:
+//  - data()/size() (SlotMap, vector) - одна непрерывная серия;
+//  - for_each_run() (SimpleForwardList над своим StaticPoolAllocator) - серии
+//    подряд занятых ячеек слаба по карте занятости;
+//  - иначе - обход итераторами по одному элементу (переходы по ссылкам).
+// Серии int32 от kMinRun значений идут в SIMD-ядра, остальное - скалярно.
+// Порядок обхода не гарантирован, поэтому только коммутативные свёртки.
+namespace reduction {
+
+// короче этого серия сворачивается на месте: вызов ядра по указателю дороже
+inline constexpr std::size_t kMinRun = 16;
+
+namespace detail {
+
+template <class C, class = void>
+struct has_for_each_run : std::false_type {};
+template <class C>
+struct has_for_each_run<C, std::void_t<decltype(std::declval<const C&>().for_each_run(
+                               std::declval<void (*)(const typename C::value_type*, std::size_t, std::size_t)>()))>>
+    : std::true_type {};
+
+template <class C, class = void>
+struct has_data_size : std::false_type {};
+template <class C>
+struct has_data_size<C, std::void_t<decltype(std::data(std::declval<const C&>())),
+                                    decltype(std::size(std::declval<const C&>()))>> : std::true_type {};
+
+// fn(first, stride, n): n значений по адресам first + k * stride байт
+template <class C, class Fn>
+void for_each_run(const C& c, Fn&& fn) {
+    using T = typename C::value_type;
+    if constexpr (has_data_size<C>::value) {
+        if (std::size(c) != 0) fn(static_cast<const T*>(std::data(c)), sizeof(T), static_cast<std::size_t>(std::size(c)));
+    } else if constexpr (has_for_each_run<C>::value) {
+        c.for_each_run(fn);
+    } else {
+        for (const T& v : c) fn(&v, sizeof(T), std::size_t{1});
+    }
+}
+
+template <class T>
+const T& at(const T* first, std::size_t stride, std::size_t k) noexcept {
+    return *reinterpret_cast<const T*>(reinterpret_cast<const char*>(first) + k * stride);
+}
+
+template <class T>
+using sum_t = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+
+} // namespace detail
+
+// sum, min, max за один проход; min/max определены при count != 0
+template <class T>
+struct Stats {
+    detail::sum_t<T> sum = 0;
+    std::size_t      count = 0;
+    T                min{};
+    T                max{};
+};
+
+template <class C>
+Stats<typename C::value_type> stats(const C& c) {
+    using T = typename C::value_type;
+    static_assert(std::is_integral_v<T>, "reduction: целые значения");
+    Stats<T> s;
+    if constexpr (std::is_same_v<T, std::int32_t>) {
+        simd::ReduceI32 r;
+        detail::for_each_run(c, [&](const T* first, std::size_t stride, std::size_t n) {
+            s.count += n;
+            if (n >= kMinRun) {
+                simd::reduce(first, stride, n, r);
+                return;
+            }
+            for (std::size_t k = 0; k < n; ++k) {
+                const T v = detail::at(first, stride, k);
+                r.sum += v;
+                r.min = v < r.min ? v : r.min;
+                r.max = v > r.max ? v : r.max;
+            }
+        });
+        s.sum = r.sum;
+        s.min = r.min;
+        s.max = r.max;
+    } else {
+        bool first_run = true;
+        detail::for_each_run(c, [&](const T* first, std::size_t stride, std::size_t n) {
+            if (first_run && n) { s.min = s.max = detail::at(first, stride, 0); first_run = false; }
+            for (std::size_t k = 0; k < n; ++k) {
+                const T v = detail::at(first, stride, k);
+                s.sum += static_cast<detail::sum_t<T>>(v);
+                s.min = v < s.min ? v : s.min;
+                s.max = v > s.max ? v : s.max;
+            }
+            s.count += n;
+        });
+    }
+    return s;
+}
+
+template <class C>
+auto sum(const C& c) {
+    return stats(c).sum;
+}
+
+template <class C>
+std::optional<typename C::value_type> min(const C& c) {
+    auto s = stats(c);
+    if (s.count == 0) return std::nullopt;
+    return s.min;
+}
+
+template <class C>
+std::optional<typename C::value_type> max(const C& c) {
+    auto s = stats(c);
+    if (s.count == 0) return std::nullopt;
+    return s.max;
+}
+
+// Предикат применяется к сериям плотным циклом без ветвлений на элемент, так
+// что простые предикаты (сравнения, маски) компилятор векторизует сам.
+template <class C, class Pred>
+std::size_t count_if(const C& c, Pred pred) {
+    using T = typename C::value_type;
+    std::size_t total = 0;
+    detail::for_each_run(c, [&](const T* first, std::size_t stride, std::size_t n) {
+        std::size_t k = 0;
+        if (stride == sizeof(T)) {
+            for (std::size_t i = 0; i < n; ++i) k += pred(first[i]) ? 1 : 0;
+        } else {
+            for (std::size_t i = 0; i < n; ++i) k += pred(detail::at(first, stride, i)) ? 1 : 0;
+        }
+        total += k;
+    });
+    return total;
+}
+
+} // namespace reduction
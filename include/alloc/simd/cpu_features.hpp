@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ALLOC_SIMD_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#else
+#define ALLOC_SIMD_X86 0
+#endif
+
+// атрибут для функций, собираемых под конкретный ISA (MSVC разрешает интринсики без флагов)
+#if ALLOC_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define ALLOC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ALLOC_TARGET(isa)
+#endif
+
+// определение возможностей CPU и выбор уровня SIMD-ядер во время выполнения
+namespace simd {
+
+// уровни упорядочены: каждый следующий включает предыдущие
+enum class Isa : int { scalar = 0, sse2 = 1, avx2 = 2, avx512 = 3 };
+
+constexpr int kIsaCount = 4;
+
+inline const char* isa_name(Isa isa) noexcept {
+    switch (isa) {
+        case Isa::sse2:   return "sse2";
+        case Isa::avx2:   return "avx2";
+        case Isa::avx512: return "avx512";
+        default:          return "scalar";
+    }
+}
+
+inline bool parse_isa(const char* s, Isa& out) noexcept {
+    for (int i = 0; i < kIsaCount; ++i) {
+        if (!std::strcmp(s, isa_name(static_cast<Isa>(i)))) {
+            out = static_cast<Isa>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// максимальный уровень, поддерживаемый процессором и ОС
+inline Isa detect_isa() noexcept {
+#if ALLOC_SIMD_X86
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Isa::avx512;
+    if (__builtin_cpu_supports("avx2"))    return Isa::avx2;
+    if (__builtin_cpu_supports("sse2"))    return Isa::sse2;
+    return Isa::scalar;
+#else
+    int r[4];
+    __cpuid(r, 0);
+    const int max_leaf = r[0];
+    __cpuid(r, 1);
+    const bool sse2    = (r[3] >> 26) & 1;
+    const bool osxsave = (r[2] >> 27) & 1;
+    if (!sse2) return Isa::scalar;
+    if (!osxsave || max_leaf < 7) return Isa::sse2;
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(r, 7, 0);
+    const bool avx2    = (r[1] >> 5) & 1;
+    const bool avx512f = (r[1] >> 16) & 1;
+    if (avx512f && (xcr0 & 0xe6) == 0xe6) return Isa::avx512;
+    if (avx2 && (xcr0 & 0x6) == 0x6) return Isa::avx2;
+    return Isa::sse2;
+#endif
+#else
+    return Isa::scalar;
+#endif
+}
+
+namespace detail {
+
+// ALLOC_ISA=scalar|sse2|avx2|avx512 ограничивает уровень сверху
+inline Isa initial_isa() noexcept {
+    Isa isa = detect_isa();
+    if (const char* env = std::getenv("ALLOC_ISA")) {
+        Isa forced;
+        if (parse_isa(env, forced) && forced < isa) isa = forced;
+    }
+    return isa;
+}
+
+// до динамической инициализации здесь 0, т.е. scalar - безопасный откат
+inline Isa g_active_isa = initial_isa();
+
+} // namespace detail
+
+inline Isa active_isa() noexcept { return detail::g_active_isa; }
+
+// принудительный выбор уровня (для бенчмарков); выше поддерживаемого не поднимается
+inline Isa force_isa(Isa isa) noexcept {
+    const Isa max = detect_isa();
+    detail::g_active_isa = isa < max ? isa : max;
+    return detail::g_active_isa;
+}
+
+} // namespace simd
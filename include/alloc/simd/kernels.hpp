@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "alloc/simd/cpu_features.hpp"
+
+// SIMD-ядра поиска по непрерывным массивам с диспетчеризацией по ISA
+namespace simd {
+
+namespace detail {
+
+inline unsigned ctz32(std::uint32_t x) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return static_cast<unsigned>(i);
+#else
+    return static_cast<unsigned>(__builtin_ctz(x));
+#endif
+}
+
+inline std::size_t find_eq_i32_scalar(const std::int32_t* p, std::size_t n, std::int32_t key) noexcept {
+    for (std::size_t i = 0; i < n; ++i)
+        if (p[i] == key) return i;
+    return n;
+}
+
+#if ALLOC_SIMD_X86
+
+ALLOC_TARGET("sse2")
+inline std::size_t find_eq_i32_sse2(const std::int32_t* p, std::size_t n, std::int32_t key) noexcept {
+    const __m128i k = _mm_set1_epi32(key);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        int m = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, k)));
+        if (m) return i + ctz32(static_cast<std::uint32_t>(m));
+    }
+    return i + find_eq_i32_scalar(p + i, n - i, key);
+}
+
+ALLOC_TARGET("avx2")
+inline std::size_t find_eq_i32_avx2(const std::int32_t* p, std::size_t n, std::int32_t key) noexcept {
+    const __m256i k = _mm256_set1_epi32(key);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        int m = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, k)));
+        if (m) return i + ctz32(static_cast<std::uint32_t>(m));
+    }
+    return i + find_eq_i32_scalar(p + i, n - i, key);
+}
+
+ALLOC_TARGET("avx512f")
+inline std::size_t find_eq_i32_avx512(const std::int32_t* p, std::size_t n, std::int32_t key) noexcept {
+    const __m512i k = _mm512_set1_epi32(key);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_loadu_si512(p + i);
+        __mmask16 m = _mm512_cmpeq_epi32_mask(v, k);
+        if (m) return i + ctz32(m);
+    }
+    return i + find_eq_i32_scalar(p + i, n - i, key);
+}
+
+#endif
+
+using FindEqI32 = std::size_t (*)(const std::int32_t*, std::size_t, std::int32_t) noexcept;
+
+// таблица реализаций по уровням Isa; недоступные уровни откатываются на младшие
+#if ALLOC_SIMD_X86
+inline constexpr FindEqI32 kFindEqI32[kIsaCount] = {
+    find_eq_i32_scalar, find_eq_i32_sse2, find_eq_i32_avx2, find_eq_i32_avx512};
+#else
+inline constexpr FindEqI32 kFindEqI32[kIsaCount] = {
+    find_eq_i32_scalar, find_eq_i32_scalar, find_eq_i32_scalar, find_eq_i32_scalar};
+#endif
+
+} // namespace detail
+
+// индекс первого элемента, равного key, либо n
+inline std::size_t find_eq(const std::int32_t* p, std::size_t n, std::int32_t key) noexcept {
+    return detail::kFindEqI32[static_cast<int>(active_isa())](p, n, key);
+}
+
+// Индекс первого из n <= 16 байт keys, равного key, либо n. keys читается
+// целиком (16 байт), хвост за n может быть любым. Для узлов дерева на горячем
+// пути: без таблицы - SSE2 есть на любом x86-64, остаётся одна проверка уровня.
+inline unsigned find_byte16(const std::uint8_t* keys, unsigned n, std::uint8_t key) noexcept {
+#if ALLOC_SIMD_X86 && (defined(__SSE2__) || defined(_M_X64))
+    if (active_isa() != Isa::scalar) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys));
+        const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(key)))))
+                           & ((1u << n) - 1);
+        return m ? detail::ctz32(m) : n;
+    }
+#endif
+    for (unsigned i = 0; i < n; ++i)
+        if (keys[i] == key) return i;
+    return n;
+}
+
+} // namespace simd
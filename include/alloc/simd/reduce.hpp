@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "alloc/simd/cpu_features.hpp"
+
+// SIMD-свёртки int32: сумма (в int64, без переполнения), минимум и максимум
+// за один проход. Серия задаётся началом, шагом в байтах и длиной: шаг 4 -
+// непрерывный массив, больший шаг - значения в ячейках пула (первое поле узла),
+// их AVX2/AVX-512 читают gather'ом. Память читается последовательно в обоих
+// случаях, так что упор - в пропускную способность, а не в задержку переходов.
+namespace simd {
+
+struct ReduceI32 {
+    std::int64_t sum = 0;
+    std::int32_t min = std::numeric_limits<std::int32_t>::max();
+    std::int32_t max = std::numeric_limits<std::int32_t>::min();
+};
+
+namespace detail {
+
+inline void reduce_i32_scalar(const char* base, std::size_t stride, std::size_t n, ReduceI32& r) noexcept {
+    std::int64_t sum = 0;
+    std::int32_t mn = r.min, mx = r.max;
+    if (stride == sizeof(std::int32_t)) {
+        // непрерывный случай отдельно: такой цикл компилятор векторизует сам
+        const auto* p = reinterpret_cast<const std::int32_t*>(base);
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += p[i];
+            mn = p[i] < mn ? p[i] : mn;
+            mx = p[i] > mx ? p[i] : mx;
+        }
+        r.sum += sum;
+        r.min = mn;
+        r.max = mx;
+        return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::int32_t v = *reinterpret_cast<const std::int32_t*>(base + i * stride);
+        sum += v;
+        mn = v < mn ? v : mn;
+        mx = v > mx ? v : mx;
+    }
+    r.sum += sum;
+    r.min = mn;
+    r.max = mx;
+}
+
+#if ALLOC_SIMD_X86
+
+// gather берёт смещения int32: 16 * stride должно укладываться в 2^31
+inline constexpr std::size_t kMaxGatherStride = std::size_t{1} << 24;
+
+ALLOC_TARGET("sse2")
+inline void reduce_i32_sse2(const char* base, std::size_t stride, std::size_t n, ReduceI32& r) noexcept {
+    if (stride != sizeof(std::int32_t)) return reduce_i32_scalar(base, stride, n, r); // без gather
+    const auto* p = reinterpret_cast<const std::int32_t*>(base);
+    __m128i s0 = _mm_setzero_si128(), s1 = _mm_setzero_si128();
+    __m128i mn = _mm_set1_epi32(r.min), mx = _mm_set1_epi32(r.max);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i sign = _mm_srai_epi32(v, 31); // расширение до int64
+        s0 = _mm_add_epi64(s0, _mm_unpacklo_epi32(v, sign));
+        s1 = _mm_add_epi64(s1, _mm_unpackhi_epi32(v, sign));
+        // pminsd/pmaxsd - SSE4.1: выбор через маску сравнения
+        const __m128i lt = _mm_cmplt_epi32(v, mn);
+        mn = _mm_or_si128(_mm_and_si128(lt, v), _mm_andnot_si128(lt, mn));
+        const __m128i gt = _mm_cmpgt_epi32(v, mx);
+        mx = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, mx));
+    }
+    alignas(16) std::int64_t s[2];
+    alignas(16) std::int32_t lo[4], hi[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(s), _mm_add_epi64(s0, s1));
+    _mm_store_si128(reinterpret_cast<__m128i*>(lo), mn);
+    _mm_store_si128(reinterpret_cast<__m128i*>(hi), mx);
+    r.sum += s[0] + s[1];
+    for (int k = 0; k < 4; ++k) {
+        r.min = lo[k] < r.min ? lo[k] : r.min;
+        r.max = hi[k] > r.max ? hi[k] : r.max;
+    }
+    reduce_i32_scalar(base + i * stride, stride, n - i, r);
+}
+
+ALLOC_TARGET("avx2")
+inline void reduce_i32_avx2(const char* base, std::size_t stride, std::size_t n, ReduceI32& r) noexcept {
+    if (stride > kMaxGatherStride) return reduce_i32_scalar(base, stride, n, r);
+    const bool dense = stride == sizeof(std::int32_t);
+    const auto st = static_cast<int>(stride);
+    const __m256i offsets = _mm256_setr_epi32(0, st, 2 * st, 3 * st, 4 * st, 5 * st, 6 * st, 7 * st);
+    __m256i s0 = _mm256_setzero_si256(), s1 = _mm256_setzero_si256();
+    __m256i mn = _mm256_set1_epi32(r.min), mx = _mm256_set1_epi32(r.max);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const char* b = base + i * stride;
+        const __m256i v = dense ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b))
+                                : _mm256_i32gather_epi32(reinterpret_cast<const int*>(b), offsets, 1);
+        s0 = _mm256_add_epi64(s0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        s1 = _mm256_add_epi64(s1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        mn = _mm256_min_epi32(mn, v);
+        mx = _mm256_max_epi32(mx, v);
+    }
+    alignas(32) std::int64_t s[4];
+    alignas(32) std::int32_t lo[8], hi[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(s), _mm256_add_epi64(s0, s1));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lo), mn);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(hi), mx);
+    r.sum += s[0] + s[1] + s[2] + s[3];
+    for (int k = 0; k < 8; ++k) {
+        r.min = lo[k] < r.min ? lo[k] : r.min;
+        r.max = hi[k] > r.max ? hi[k] : r.max;
+    }
+    reduce_i32_scalar(base + i * stride, stride, n - i, r);
+}
+
+ALLOC_TARGET("avx512f")
+inline void reduce_i32_avx512(const char* base, std::size_t stride, std::size_t n, ReduceI32& r) noexcept {
+    if (stride > kMaxGatherStride) return reduce_i32_scalar(base, stride, n, r);
+    const bool dense = stride == sizeof(std::int32_t);
+    const __m512i offsets = _mm512_mullo_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm512_set1_epi32(static_cast<int>(stride)));
+    __m512i s0 = _mm512_setzero_si512(), s1 = _mm512_setzero_si512();
+    __m512i mn = _mm512_set1_epi32(r.min), mx = _mm512_set1_epi32(r.max);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const char* b = base + i * stride;
+        const __m512i v = dense ? _mm512_loadu_si512(b) : _mm512_i32gather_epi32(offsets, b, 1);
+        s0 = _mm512_add_epi64(s0, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+        s1 = _mm512_add_epi64(s1, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+        mn = _mm512_min_epi32(mn, v);
+        mx = _mm512_max_epi32(mx, v);
+    }
+    r.sum += _mm512_reduce_add_epi64(_mm512_add_epi64(s0, s1));
+    r.min = _mm512_reduce_min_epi32(mn);
+    r.max = _mm512_reduce_max_epi32(mx);
+    reduce_i32_scalar(base + i * stride, stride, n - i, r);
+}
+
+#endif
+
+using ReduceI32Fn = void (*)(const char*, std::size_t, std::size_t, ReduceI32&) noexcept;
+
+#if ALLOC_SIMD_X86
+inline constexpr ReduceI32Fn kReduceI32[kIsaCount] = {
+    reduce_i32_scalar, reduce_i32_sse2, reduce_i32_avx2, reduce_i32_avx512};
+#else
+inline constexpr ReduceI32Fn kReduceI32[kIsaCount] = {
+    reduce_i32_scalar, reduce_i32_scalar, reduce_i32_scalar, reduce_i32_scalar};
+#endif
+
+} // namespace detail
+
+// добавляет к r n значений по адресам first + k * stride байт
+inline void reduce(const std::int32_t* first, std::size_t stride, std::size_t n, ReduceI32& r) noexcept {
+    detail::kReduceI32[static_cast<int>(active_isa())](reinterpret_cast<const char*>(first), stride, n, r);
+}
+
+} // namespace simd
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "alloc/simd/cpu_features.hpp"
+#include "alloc/simd/kernels.hpp"
+
+// SIMD-поиск в малых отсортированных массивах (ключи узлов, таблицы классов):
+// индекс первого элемента >= key. В отсортированном массиве это просто число
+// элементов < key, так что сравниваются все блоки подряд и маски суммируются -
+// без ветвлений, зависящих от ключа. Блок из 4/8/16 ключей - одно сравнение.
+namespace simd {
+
+namespace detail {
+
+inline unsigned popcount32(std::uint32_t x) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned c = 0;
+    for (; x; x &= x - 1) ++c;
+    return c;
+#else
+    return static_cast<unsigned>(__builtin_popcount(x));
+#endif
+}
+
+template <class T>
+inline std::size_t lower_bound_scalar(const T* p, std::size_t n, T key) noexcept {
+    std::size_t c = 0;
+    for (std::size_t i = 0; i < n; ++i) c += p[i] < key;
+    return c;
+}
+
+#if ALLOC_SIMD_X86
+
+ALLOC_TARGET("sse2")
+inline std::size_t lower_bound_i32_sse2(const std::int32_t* p, std::size_t n, std::int32_t key) noexcept {
+    // без popcnt: маски сравнения (-1 в подходящих lanes) вычитаются из счётчика
+    const __m128i k = _mm_set1_epi32(key);
+    __m128i acc = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        acc = _mm_sub_epi32(acc, _mm_cmplt_epi32(v, k));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    const auto c = static_cast<std::size_t>(_mm_cvtsi128_si32(acc));
+    return c + lower_bound_scalar(p + i, n - i, key);
+}
+
+ALLOC_TARGET("avx2,popcnt")
+inline std::size_t lower_bound_i32_avx2(const std::int32_t* p, std::size_t n, std::int32_t key) noexcept {
+    const __m256i k = _mm256_set1_epi32(key);
+    std::size_t i = 0, c = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        c += popcount32(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, v)))));
+    }
+    if (i + 4 <= n) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        c += popcount32(static_cast<unsigned>(
+            _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, _mm256_castsi256_si128(k))))));
+        i += 4;
+    }
+    return c + lower_bound_scalar(p + i, n - i, key);
+}
+
+ALLOC_TARGET("avx512f,popcnt")
+inline std::size_t lower_bound_i32_avx512(const std::int32_t* p, std::size_t n, std::int32_t key) noexcept {
+    const __m512i k = _mm512_set1_epi32(key);
+    std::size_t i = 0, c = 0;
+    for (; i + 16 <= n; i += 16) {
+        c += popcount32(_mm512_cmplt_epi32_mask(_mm512_loadu_si512(p + i), k));
+    }
+    // хвост - одним маскированным чтением, за границу массива не выходит
+    if (i < n) {
+        const __mmask16 tail = static_cast<__mmask16>((1u << (n - i)) - 1);
+        c += popcount32(_mm512_mask_cmplt_epi32_mask(tail, _mm512_maskz_loadu_epi32(tail, p + i), k));
+    }
+    return c;
+}
+
+// у SSE2 нет сравнения 64-битных целых (pcmpgtq - SSE4.2): на этом уровне - скалярный код
+ALLOC_TARGET("avx2,popcnt")
+inline std::size_t lower_bound_i64_avx2(const std::int64_t* p, std::size_t n, std::int64_t key) noexcept {
+    const __m256i k = _mm256_set1_epi64x(key);
+    std::size_t i = 0, c = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        c += popcount32(static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(k, v)))));
+    }
+    return c + lower_bound_scalar(p + i, n - i, key);
+}
+
+ALLOC_TARGET("avx512f,popcnt")
+inline std::size_t lower_bound_i64_avx512(const std::int64_t* p, std::size_t n, std::int64_t key) noexcept {
+    const __m512i k = _mm512_set1_epi64(key);
+    std::size_t i = 0, c = 0;
+    for (; i + 8 <= n; i += 8) {
+        c += popcount32(_mm512_cmplt_epi64_mask(_mm512_loadu_si512(p + i), k));
+    }
+    if (i < n) {
+        const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+        c += popcount32(_mm512_mask_cmplt_epi64_mask(tail, _mm512_maskz_loadu_epi64(tail, p + i), k));
+    }
+    return c;
+}
+
+#endif
+
+using LowerBoundI32 = std::size_t (*)(const std::int32_t*, std::size_t, std::int32_t) noexcept;
+using LowerBoundI64 = std::size_t (*)(const std::int64_t*, std::size_t, std::int64_t) noexcept;
+
+#if ALLOC_SIMD_X86
+inline constexpr LowerBoundI32 kLowerBoundI32[kIsaCount] = {
+    lower_bound_scalar<std::int32_t>, lower_bound_i32_sse2, lower_bound_i32_avx2, lower_bound_i32_avx512};
+inline constexpr LowerBoundI64 kLowerBoundI64[kIsaCount] = {
+    lower_bound_scalar<std::int64_t>, lower_bound_scalar<std::int64_t>, lower_bound_i64_avx2, lower_bound_i64_avx512};
+#else
+inline constexpr LowerBoundI32 kLowerBoundI32[kIsaCount] = {
+    lower_bound_scalar<std::int32_t>, lower_bound_scalar<std::int32_t>,
+    lower_bound_scalar<std::int32_t>, lower_bound_scalar<std::int32_t>};
+inline constexpr LowerBoundI64 kLowerBoundI64[kIsaCount] = {
+    lower_bound_scalar<std::int64_t>, lower_bound_scalar<std::int64_t>,
+    lower_bound_scalar<std::int64_t>, lower_bound_scalar<std::int64_t>};
+#endif
+
+} // namespace detail
+
+// индекс первого элемента >= key в отсортированном p[0, n), либо n;
+// рассчитано на малые n (узлы по 4..64 ключа), большие массивы - std::lower_bound
+inline std::size_t lower_bound(const std::int32_t* p, std::size_t n, std::int32_t key) noexcept {
+    return detail::kLowerBoundI32[static_cast<int>(active_isa())](p, n, key);
+}
+
+inline std::size_t lower_bound(const std::int64_t* p, std::size_t n, std::int64_t key) noexcept {
+    return detail::kLowerBoundI64[static_cast<int>(active_isa())](p, n, key);
+}
+
+// То же для n <= 16 байт keys (узлы Node16 дерева): keys читается целиком,
+// хвост за n может быть любым. Как find_byte16 - без таблицы, одна проверка уровня.
+inline unsigned lower_bound_byte16(const std::uint8_t* keys, unsigned n, std::uint8_t key) noexcept {
+#if ALLOC_SIMD_X86 && (defined(__SSE2__) || defined(_M_X64))
+    if (active_isa() != Isa::scalar) {
+        // сравнение байтов в SSE2 знаковое: сдвиг на 0x80 делает его беззнаковым
+        const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+        const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys)), bias);
+        const __m128i k = _mm_xor_si128(_mm_set1_epi8(static_cast<char>(key)), bias);
+        const auto lt = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(v, k)));
+        // первые n отсортированы, так что меньшие key - префикс маски
+        return detail::ctz32(~lt | (1u << n));
+    }
+#endif
+    unsigned i = 0;
+    while (i < n && keys[i] < key) ++i;
+    return i;
+}
+
+} // namespace simd
@@ -0,0 +1,450 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "alloc/static_pool_allocator.hpp"
+
+namespace detail {
+
+// аллокатор умеет обходить свои живые ячейки (StaticPoolAllocator::for_each_live)
+template <class A, class = void>
+struct has_for_each_live : std::false_type {};
+template <class A>
+struct has_for_each_live<A, std::void_t<decltype(A::for_each_live(std::declval<void (*)(typename A::value_type&)>()))>>
+    : std::true_type {};
+
+// Uses-allocator конструирование (аналог C++20 make_obj_using_allocator):
+// allocator-aware T получает аллокатор контейнера, остальные - только args.
+// Возвращает prvalue, так что T строится сразу на месте назначения.
+template <class T, class A, class... Args>
+T make_using_allocator(const A& a, Args&&... args) {
+    if constexpr (!std::uses_allocator_v<T, A>)
+        return T(std::forward<Args>(args)...);
+    else if constexpr (std::is_constructible_v<T, std::allocator_arg_t, const A&, Args...>)
+        return T(std::allocator_arg, a, std::forward<Args>(args)...);
+    else if constexpr (std::is_constructible_v<T, Args..., const A&>)
+        return T(std::forward<Args>(args)..., a);
+    else
+        return T(std::forward<Args>(args)...);
+}
+
+// Встроенный буфер на K узлов внутри самого списка (small-buffer optimization).
+// Свободные ячейки связаны через их первые байты, как в StaticPoolAllocator.
+template <class Node, std::size_t K>
+class InlineNodes {
+public:
+    InlineNodes() = default;
+    InlineNodes(const InlineNodes&) = delete;
+    InlineNodes& operator=(const InlineNodes&) = delete;
+
+    Node* try_get() noexcept {
+        if (free_) {
+            void* p = free_;
+            free_ = *static_cast<void**>(p);
+            ++live_;
+            return static_cast<Node*>(p);
+        }
+        if (used_ < K) {
+            ++live_;
+            return reinterpret_cast<Node*>(&slots_[used_++]);
+        }
+        return nullptr;
+    }
+
+    bool owns(const Node* n) const noexcept {
+        auto p = reinterpret_cast<const unsigned char*>(n);
+        auto b = reinterpret_cast<const unsigned char*>(slots_);
+        return p >= b && p < b + sizeof(slots_);
+    }
+
+    void put(Node* n) noexcept {
+        *reinterpret_cast<void**>(n) = free_;
+        free_ = n;
+        --live_;
+    }
+
+    // все ячейки свободны
+    void reset() noexcept { used_ = live_ = 0; free_ = nullptr; }
+
+    std::size_t live() const noexcept { return live_; }
+
+private:
+    std::aligned_storage_t<sizeof(Node), alignof(Node)> slots_[K];
+    std::size_t used_ = 0;
+    std::size_t live_ = 0;
+    void*       free_ = nullptr;
+};
+
+template <class Node>
+class InlineNodes<Node, 0> {
+public:
+    Node* try_get() noexcept { return nullptr; }
+    bool owns(const Node*) const noexcept { return false; }
+    void put(Node*) noexcept {}
+    void reset() noexcept {}
+    std::size_t live() const noexcept { return 0; }
+};
+
+} // namespace detail
+
+// Простой однонаправленный список параметризуемый аллокатором.
+// InlineN > 0 - первые узлы берутся из буфера внутри самого списка, аллокатор
+// нужен только при переполнении.
+template <class T, class Alloc = std::allocator<T>, std::size_t InlineN = 0>
+class SimpleForwardList {
+    struct Node {
+        T value;
+        Node* next = nullptr;
+
+        // значение строится прямо в узле, без временного T
+        template <class... Args>
+        Node(std::in_place_t, const Alloc& a, Args&&... args)
+            : value(detail::make_using_allocator<T>(a, std::forward<Args>(args)...)) {}
+    };
+
+    using NodeAlloc  = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using node_allocator_type = NodeAlloc; // для compact() пула, разделяемого несколькими списками
+
+    SimpleForwardList() = default;
+    explicit SimpleForwardList(const Alloc& a): alloc_(a) {}
+    ~SimpleForwardList() { clear(); }
+
+    SimpleForwardList(const SimpleForwardList&) = delete;
+    SimpleForwardList& operator=(const SimpleForwardList&) = delete;
+
+    // узлы из аллокатора забираются целиком, встроенные - перемещаются поэлементно
+    SimpleForwardList(SimpleForwardList&& r) : alloc_(std::move(r.alloc_)) { take_(r); }
+
+    SimpleForwardList& operator=(SimpleForwardList&& r) {
+        if (this == &r) return *this;
+        clear();
+        if constexpr (NodeTraits::propagate_on_container_move_assignment::value) alloc_ = r.alloc_;
+        if (alloc_ == r.alloc_) {
+            take_(r);
+        } else {
+            for (Node* n = r.head_; n; n = n->next) emplace_back(std::move(n->value));
+            r.clear();
+        }
+        return *this;
+    }
+
+    void push_back(const T& v) { emplace_back(v); }
+    void push_back(T&& v)      { emplace_back(std::move(v)); }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        Node* n = allocate_node_();
+        try {
+            NodeTraits::construct(alloc_, n, std::in_place, get_allocator(), std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate_node_(n);
+            throw;
+        }
+        try {
+            link_back_(n);
+        } catch (...) {
+            NodeTraits::destroy(alloc_, n);
+            deallocate_node_(n);
+            throw;
+        }
+        return n->value;
+    }
+
+    T& front() noexcept { return head_->value; }
+    const T& front() const noexcept { return head_->value; }
+
+    // снятие с головы; с включённым индексом он перестраивается за O(n),
+    // поэтому для очередей индекс не включают
+    void pop_front() noexcept {
+        Node* n = head_;
+        head_ = n->next;
+        if (!head_) tail_ = nullptr;
+        --sz_;
+        NodeTraits::destroy(alloc_, n);
+        deallocate_node_(n);
+        if (has_index()) rebuild_index_(); // без выделений: индекс только уменьшается
+    }
+
+    void clear() noexcept {
+        // при быстром выходе узлы без деструкторов не обходим вовсе
+        if (std::is_trivially_destructible_v<T> && pool_fast_exit_enabled()) {
+            inline_.reset();
+            index_.clear();
+            head_ = tail_ = nullptr;
+            sz_ = 0;
+            return;
+        }
+        Node* cur = head_;
+        while (cur) {
+            Node* nxt = cur->next;
+            NodeTraits::destroy(alloc_, cur);
+            if (!inline_.owns(cur)) NodeTraits::deallocate(alloc_, cur, 1);
+            cur = nxt;
+        }
+        inline_.reset();
+        index_.clear();
+        head_ = tail_ = nullptr;
+        sz_ = 0;
+    }
+
+    // Исправляет ссылки на узлы, перенесённые при StaticPoolAllocator::compact.
+    // Вызывается из fixup для каждого списка, разделяющего пул узлов.
+    template <class Relocation>
+    void relink(const Relocation& reloc) noexcept {
+        head_ = reloc(head_);
+        for (Node* n = head_; n; n = n->next) n->next = reloc(n->next);
+        tail_ = reloc(tail_);
+        for (auto& n : index_) n = reloc(n);
+    }
+
+    // Дефрагментация пула узлов (только для StaticPoolAllocator): узлы
+    // раскладываются по слабу в порядке обхода, итерация идёт последовательно.
+    // Пул общий для всех списков с тем же NodeAlloc, а relink() вызывается только
+    // для *this, поэтому работает лишь когда список - единственный пользователь
+    // пула; иначе ничего не делает и возвращает false. Для разделяемого пула -
+    // node_allocator_type::compact с fixup, вызывающим relink() у каждого списка.
+    bool compact() {
+        if (inline_.live() != 0 || NodeAlloc::live_count() != sz_) return false;
+        NodeAlloc::compact([this](const auto& reloc) { relink(reloc); });
+        if (sz_ != 0) order_slots_();
+        return true;
+    }
+
+    // Обход без гарантии порядка. Если узлы лежат в StaticPoolAllocator и список -
+    // единственный его пользователь, читает слаб последовательно по карте занятости.
+    template <class Fn>
+    void for_each_unordered(Fn&& fn) {
+        if constexpr (detail::has_for_each_live<NodeAlloc>::value) {
+            if (inline_.live() == 0 && NodeAlloc::live_count() == sz_) {
+                NodeAlloc::for_each_live([&](Node& n) { fn(n.value); });
+                return;
+            }
+        }
+        for (Node* n = head_; n; n = n->next) fn(n->value);
+    }
+
+    // Обход сериями для векторных ядер: fn(first, stride, n) - n значений по
+    // адресам first + k * stride байт, без гарантии порядка. Если узлы в
+    // StaticPoolAllocator и список - единственный его пользователь, серии -
+    // подряд занятые ячейки слаба; иначе - по узлу на вызов в порядке списка.
+    template <class Fn>
+    void for_each_run(Fn&& fn) const {
+        if constexpr (detail::has_for_each_live<NodeAlloc>::value) {
+            if (inline_.live() == 0 && NodeAlloc::live_count() == sz_) {
+                NodeAlloc::for_each_live_run([&](Node* first, std::size_t n) {
+                    fn(static_cast<const T*>(&first->value), NodeAlloc::slot_size(), n);
+                });
+                return;
+            }
+        }
+        for (const Node* n = head_; n; n = n->next) fn(&n->value, sizeof(Node), std::size_t{1});
+    }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(alloc_); }
+
+    bool empty() const noexcept { return sz_ == 0; }
+    std::size_t size() const noexcept { return sz_; }
+
+    struct iterator {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Node* p = nullptr;
+        iterator() = default;
+        explicit iterator(Node* n): p(n) {}
+        reference operator*() const { return p->value; }
+        pointer operator->() const { return &p->value; }
+        iterator& operator++() { p = p->next; return *this; }
+        iterator operator++(int) { iterator tmp(*this); ++(*this); return tmp; }
+        bool operator==(const iterator& r) const { return p == r.p; }
+        bool operator!=(const iterator& r) const { return p != r.p; }
+    };
+
+    iterator begin() noexcept { return iterator(head_); }
+    iterator end() noexcept { return iterator(nullptr); }
+
+    // Разреженный индекс: указатель на каждый 2^log2_stride-й узел, поддерживается
+    // при добавлении в конец. Даёт nth() за O(2^log2_stride) и дешёвое деление на части.
+    void build_index(unsigned log2_stride = 6) {
+        index_shift_ = static_cast<int>(log2_stride);
+        rebuild_index_();
+    }
+
+    void drop_index() noexcept {
+        index_shift_ = -1;
+        index_.clear();
+        index_.shrink_to_fit();
+    }
+
+    bool has_index() const noexcept { return index_shift_ >= 0; }
+
+    // итератор на k-й элемент (k <= size(), k == size() - end())
+    iterator iter_at(std::size_t k) noexcept {
+        if (k >= sz_) return end();
+        Node* n = head_;
+        std::size_t steps = k;
+        if (has_index()) {
+            n = index_[k >> index_shift_];
+            steps = k & ((std::size_t{1} << index_shift_) - 1);
+        }
+        while (steps--) n = n->next;
+        return iterator(n);
+    }
+
+    T& nth(std::size_t k) noexcept { return *iter_at(k); }
+
+    // parts+1 границ примерно равных кусков: [b[i], b[i+1]) - i-й кусок.
+    // С индексом - O(parts * stride), без него - один проход по списку.
+    std::vector<iterator> split(std::size_t parts) {
+        if (parts == 0) parts = 1;
+        std::vector<iterator> bounds;
+        bounds.reserve(parts + 1);
+        if (has_index()) {
+            for (std::size_t i = 0; i < parts; ++i) bounds.push_back(iter_at(sz_ * i / parts));
+        } else {
+            Node* n = head_;
+            std::size_t pos = 0;
+            for (std::size_t i = 0; i < parts; ++i) {
+                const std::size_t target = sz_ * i / parts;
+                for (; pos < target; ++pos) n = n->next;
+                bounds.push_back(iterator(n));
+            }
+        }
+        bounds.push_back(end());
+        return bounds;
+    }
+
+    // fn(first, last, first_index) для кусков по chunk элементов, начиная с from
+    template <class Fn>
+    void for_each_chunk(std::size_t chunk, Fn&& fn, std::size_t from = 0) {
+        if (chunk == 0) chunk = 1;
+        iterator it = iter_at(from);
+        for (std::size_t i = from; i < sz_; i += chunk) {
+            iterator last = it;
+            for (std::size_t k = 0; k < chunk && last != end(); ++k) ++last;
+            fn(it, last, i);
+            it = last;
+        }
+    }
+
+private:
+    Node* allocate_node_() {
+        if (Node* n = inline_.try_get()) return n;
+        return NodeTraits::allocate(alloc_, 1);
+    }
+
+    void deallocate_node_(Node* n) noexcept {
+        if (inline_.owns(n)) inline_.put(n);
+        else NodeTraits::deallocate(alloc_, n, 1);
+    }
+
+    // может бросить только из-за роста индекса, до изменения списка
+    void link_back_(Node* n) {
+        if (has_index() && (sz_ & ((std::size_t{1} << index_shift_) - 1)) == 0) index_.push_back(n);
+        n->next = nullptr;
+        if (!head_) { head_ = tail_ = n; }
+        else { tail_->next = n; tail_ = n; }
+        ++sz_;
+    }
+
+    // Забирает узлы r (аллокаторы равны, *this пуст); r остаётся пустым.
+    // Встроенные узлы r всегда помещаются во встроенный буфер *this.
+    void take_(SimpleForwardList& r) {
+        index_shift_ = r.index_shift_;
+        if (r.inline_.live() == 0) {
+            head_  = std::exchange(r.head_, nullptr);
+            tail_  = std::exchange(r.tail_, nullptr);
+            sz_    = std::exchange(r.sz_, 0);
+            index_ = std::move(r.index_);
+            r.index_.clear();
+            return;
+        }
+        r.index_.clear();
+        if constexpr (InlineN > 0) take_mixed_(r);
+    }
+
+    void take_mixed_(SimpleForwardList& r) {
+        Node* cur = std::exchange(r.head_, nullptr);
+        r.tail_ = nullptr;
+        r.sz_ = 0;
+        while (cur) {
+            Node* nxt = cur->next;
+            if (r.inline_.owns(cur)) {
+                Node* n = allocate_node_();
+                NodeTraits::construct(alloc_, n, std::move(*cur));
+                NodeTraits::destroy(r.alloc_, cur);
+                link_back_(n);
+            } else {
+                link_back_(cur);
+            }
+            cur = nxt;
+        }
+        r.inline_.reset();
+    }
+
+    // после compact узлы занимают ячейки [0, sz_); переставляем их циклами перестановки
+    void order_slots_() {
+        std::vector<std::size_t> src(sz_); // src[i] - ячейка, где сейчас i-й узел
+        std::size_t i = 0;
+        for (Node* n = head_; n; n = n->next) src[i++] = NodeAlloc::slot_index(n);
+
+        auto slot = [](std::size_t k) { return NodeAlloc::slot_at(k); };
+        auto move_node = [](Node* to, Node* from) {
+            ::new (static_cast<void*>(to)) Node(std::move(*from));
+            from->~Node();
+        };
+
+        std::vector<bool> done(sz_);
+        alignas(Node) unsigned char tmp_buf[sizeof(Node)];
+        Node* tmp = reinterpret_cast<Node*>(tmp_buf);
+        for (std::size_t s = 0; s < sz_; ++s) {
+            if (done[s]) continue;
+            done[s] = true;
+            if (src[s] == s) continue;
+            move_node(tmp, slot(s));
+            std::size_t j = s;
+            for (std::size_t k = src[j]; k != s; k = src[j]) {
+                move_node(slot(j), slot(k));
+                done[k] = true;
+                j = k;
+            }
+            move_node(slot(j), tmp);
+        }
+
+        for (i = 0; i + 1 < sz_; ++i) slot(i)->next = slot(i + 1);
+        slot(sz_ - 1)->next = nullptr;
+        head_ = slot(0);
+        tail_ = slot(sz_ - 1);
+        rebuild_index_();
+    }
+
+    void rebuild_index_() {
+        index_.clear();
+        if (!has_index()) return;
+        const std::size_t mask = (std::size_t{1} << index_shift_) - 1;
+        std::size_t i = 0;
+        for (Node* n = head_; n; n = n->next, ++i)
+            if ((i & mask) == 0) index_.push_back(n);
+    }
+
+    NodeAlloc   alloc_{};
+    detail::InlineNodes<Node, InlineN> inline_;
+    Node*       head_ = nullptr;
+    Node*       tail_ = nullptr;
+    std::size_t sz_    = 0;
+    std::vector<Node*> index_;     // узлы с номерами, кратными 2^index_shift_
+    int         index_shift_ = -1; // -1 - индекс выключен
+};
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include "alloc/simd/search.hpp"
+#include "alloc/static_pool_allocator.hpp"
+
+// Пул блоков переменного размера: запрос округляется вверх до класса, у каждого
+// класса свой слаб StaticPoolAllocator под mutex'ом, а перед ним - кэш потока
+// без блокировок. Запросы крупнее kMaxSize и сверх ёмкости класса пул не
+// обслуживает (allocate -> nullptr), решение о запасном пути - за вызывающим.
+namespace size_class {
+
+inline constexpr std::size_t kSizes[] = {
+    16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256,
+    320, 384, 448, 512, 640, 768, 896, 1024,
+};
+inline constexpr std::size_t kClasses = sizeof(kSizes) / sizeof(kSizes[0]);
+inline constexpr std::size_t kMaxSize = kSizes[kClasses - 1];
+
+// виртуальный объём слаба каждого класса; страницы занимаются по мере нарезки
+inline constexpr std::size_t kClassBytes = std::size_t{16} << 20;
+
+// кэш потока: сколько блоков класса держать и сколько брать из слаба за раз
+inline constexpr std::uint32_t kCacheMax = 64;
+inline constexpr std::uint32_t kBatch    = 32;
+
+namespace detail {
+
+// kSizes в int32 для SIMD-поиска
+alignas(64) inline constexpr std::array<std::int32_t, kClasses> kSizes32 = [] {
+    std::array<std::int32_t, kClasses> a{};
+    for (std::size_t c = 0; c < kClasses; ++c) a[c] = static_cast<std::int32_t>(kSizes[c]);
+    return a;
+}();
+
+} // namespace detail
+
+// номер класса для n байт или kClasses, если n > kMaxSize
+inline std::size_t class_of(std::size_t n) noexcept {
+    if (n > kMaxSize) return kClasses;
+    return simd::lower_bound(detail::kSizes32.data(), kClasses, static_cast<std::int32_t>(n));
+}
+
+namespace detail {
+
+struct FreeBlock { FreeBlock* next; };
+
+template <std::size_t C>
+struct ClassPool {
+    struct alignas(alignof(std::max_align_t)) Block { unsigned char bytes[kSizes[C]]; };
+    using Pool = StaticPoolAllocator<Block, kClassBytes / sizeof(Block)>;
+
+    static void* allocate() { return Pool().allocate(1); }
+    static void deallocate(void* p) noexcept { Pool().deallocate(static_cast<Block*>(p), 1); }
+    static void* first() noexcept { return Pool::slot_at(0); }
+    static void* last() noexcept { return Pool::slot_at(Pool::capacity()); }
+};
+
+struct ClassOps {
+    void* (*allocate)();
+    void (*deallocate)(void*) noexcept;
+    void* (*first)() noexcept;
+    void* (*last)() noexcept;
+};
+
+template <std::size_t... I>
+constexpr std::array<ClassOps, kClasses> make_ops(std::index_sequence<I...>) {
+    return {{ClassOps{&ClassPool<I>::allocate, &ClassPool<I>::deallocate,
+                      &ClassPool<I>::first, &ClassPool<I>::last}...}};
+}
+
+inline constexpr std::array<ClassOps, kClasses> kOps = make_ops(std::make_index_sequence<kClasses>{});
+
+// общая часть класса: mutex и диапазон адресов слаба (0, пока слаба нет)
+struct alignas(64) Central {
+    std::mutex                 mutex;
+    std::atomic<std::uintptr_t> lo{0};
+    std::atomic<std::uintptr_t> hi{0};
+};
+inline Central g_central[kClasses];
+
+// Слабы по возрастанию адреса для owner_of. Слаб класса появляется один раз и
+// живёт до конца процесса, поэтому каждый снимок неизменен после публикации:
+// снимок k содержит k слабов, читатель берёт текущий одной acquire-загрузкой.
+struct SlabMap {
+    std::size_t  count;
+    std::int64_t lo[kClasses];
+    std::int64_t hi[kClasses];
+    std::uint8_t cls[kClasses];
+};
+inline SlabMap               g_slab_maps[kClasses + 1];
+inline std::atomic<SlabMap*> g_slab_map{&g_slab_maps[0]};
+inline std::mutex            g_slab_map_mutex;
+
+// вызывается один раз на класс, под его mutex'ом
+inline void publish_slab(std::size_t c, std::uintptr_t lo, std::uintptr_t hi) noexcept {
+    std::lock_guard<std::mutex> lock(g_slab_map_mutex);
+    const SlabMap& cur = *g_slab_map.load(std::memory_order_relaxed);
+    SlabMap& next = g_slab_maps[cur.count + 1];
+    const auto a = static_cast<std::int64_t>(lo);
+    const std::size_t pos = simd::lower_bound(cur.lo, cur.count, a);
+    for (std::size_t i = 0, j = 0; i <= cur.count; ++i, ++j) {
+        if (i == pos) {
+            next.lo[j] = a;
+            next.hi[j] = static_cast<std::int64_t>(hi);
+            next.cls[j] = static_cast<std::uint8_t>(c);
+            ++j;
+        }
+        if (i == cur.count) break;
+        next.lo[j] = cur.lo[i];
+        next.hi[j] = cur.hi[i];
+        next.cls[j] = cur.cls[i];
+    }
+    next.count = cur.count + 1;
+    g_slab_map.store(&next, std::memory_order_release);
+}
+
+// Кэш потока тривиально разрушаем, поэтому доступен в любой момент жизни
+// потока. Возврат блоков в слабы при завершении потока делает отдельный
+// ThreadExit, который регистрируется при первом обращении к слабу.
+struct ThreadCache {
+    FreeBlock*    head[kClasses];
+    std::uint32_t count[kClasses];
+    bool          registered;
+    bool          exited; // после ThreadExit блоки идут мимо кэша
+};
+inline thread_local ThreadCache tls_cache{};
+
+inline void flush(ThreadCache& tc, std::size_t c, std::uint32_t keep) noexcept {
+    if (tc.count[c] <= keep) return;
+    std::lock_guard<std::mutex> lock(g_central[c].mutex);
+    while (tc.count[c] > keep) {
+        FreeBlock* b = tc.head[c];
+        tc.head[c] = b->next;
+        --tc.count[c];
+        kOps[c].deallocate(b);
+    }
+}
+
+struct ThreadExit {
+    ~ThreadExit() {
+        ThreadCache& tc = tls_cache;
+        tc.exited = true;
+        for (std::size_t c = 0; c < kClasses; ++c) flush(tc, c, 0);
+    }
+};
+
+// Первый блок слаба класса не освобождается никогда: live не падает до нуля,
+// Reaper не отдаёт слаб, и диапазон адресов класса постоянен до конца процесса.
+inline void anchor_slab(std::size_t c) {
+    if (g_central[c].hi.load(std::memory_order_relaxed)) return;
+    (void)kOps[c].allocate();
+    g_central[c].lo.store(reinterpret_cast<std::uintptr_t>(kOps[c].first()), std::memory_order_relaxed);
+    g_central[c].hi.store(reinterpret_cast<std::uintptr_t>(kOps[c].last()), std::memory_order_release);
+    publish_slab(c, g_central[c].lo.load(std::memory_order_relaxed), g_central[c].hi.load(std::memory_order_relaxed));
+}
+
+ALLOC_NOINLINE inline void* refill(ThreadCache& tc, std::size_t c) noexcept {
+    if (!tc.registered && !tc.exited) {
+        tc.registered = true;
+        static thread_local ThreadExit on_exit;
+        (void)&on_exit;
+    }
+    const std::uint32_t want = tc.exited ? 1 : kBatch;
+    void* got = nullptr;
+    std::lock_guard<std::mutex> lock(g_central[c].mutex);
+    try {
+        anchor_slab(c);
+        got = kOps[c].allocate();
+        for (std::uint32_t i = 1; i < want; ++i) {
+            auto b = static_cast<FreeBlock*>(kOps[c].allocate());
+            b->next = tc.head[c];
+            tc.head[c] = b;
+            ++tc.count[c];
+        }
+    } catch (const std::bad_alloc&) {
+        // класс исчерпан: отдаём то, что успели взять
+    }
+    return got;
+}
+
+} // namespace detail
+
+// класс, в слабе которого лежит p, или kClasses: последний слаб с началом <= p
+inline std::size_t owner_of(const void* p) noexcept {
+    const auto a = static_cast<std::int64_t>(reinterpret_cast<std::uintptr_t>(p));
+    const detail::SlabMap& m = *detail::g_slab_map.load(std::memory_order_acquire);
+    const std::size_t i = simd::lower_bound(m.lo, m.count, a + 1);
+    if (i == 0 || a >= m.hi[i - 1]) return kClasses;
+    return m.cls[i - 1];
+}
+
+// блок не меньше n байт или nullptr
+inline void* allocate(std::size_t n) noexcept {
+    const std::size_t c = class_of(n);
+    if (ALLOC_UNLIKELY(c == kClasses)) return nullptr;
+    detail::ThreadCache& tc = detail::tls_cache;
+    if (detail::FreeBlock* b = tc.head[c]) {
+        tc.head[c] = b->next;
+        --tc.count[c];
+        return b;
+    }
+    return detail::refill(tc, c);
+}
+
+// возврат блока класса c; переполненный кэш сбрасывает половину в слаб
+inline void deallocate_class(void* p, std::size_t c) noexcept {
+    detail::ThreadCache& tc = detail::tls_cache;
+    if (ALLOC_UNLIKELY(tc.exited)) {
+        std::lock_guard<std::mutex> lock(detail::g_central[c].mutex);
+        detail::kOps[c].deallocate(p);
+        return;
+    }
+    auto b = static_cast<detail::FreeBlock*>(p);
+    b->next = tc.head[c];
+    tc.head[c] = b;
+    if (ALLOC_UNLIKELY(++tc.count[c] > kCacheMax)) detail::flush(tc, c, kCacheMax / 2);
+}
+
+// false - p не из пула (тогда его освобождает вызывающий)
+inline bool deallocate(void* p, std::size_t n) noexcept {
+    const std::size_t c = class_of(n);
+    if (c == kClasses || !p) return false;
+    const auto a = reinterpret_cast<std::uintptr_t>(p);
+    if (a >= detail::g_central[c].hi.load(std::memory_order_acquire) ||
+        a < detail::g_central[c].lo.load(std::memory_order_relaxed))
+        return false;
+    deallocate_class(p, c);
+    return true;
+}
+
+// без размера: класс определяется по адресу
+inline bool deallocate(void* p) noexcept {
+    const std::size_t c = owner_of(p);
+    if (c == kClasses) return false;
+    deallocate_class(p, c);
+    return true;
+}
+
+} // namespace size_class
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// 8-байтовая ссылка на ячейку: индекс + поколение.
+// После освобождения ячейки поколение растёт, и старые handle перестают резолвиться.
+struct PoolHandle {
+    std::uint32_t index      = 0;
+    std::uint32_t generation = 0; // 0 - невалидный handle
+
+    explicit operator bool() const noexcept { return generation != 0; }
+    bool operator==(const PoolHandle& r) const noexcept { return index == r.index && generation == r.generation; }
+    bool operator!=(const PoolHandle& r) const noexcept { return !(*this == r); }
+};
+
+static_assert(sizeof(PoolHandle) == 8, "PoolHandle must stay 8 bytes");
+
+// контейнер на N ячеек с доступом по PoolHandle за O(1).
+// Значения лежат плотно (без дыр), поэтому обход идёт по непрерывному массиву.
+template <class T, std::size_t N>
+class SlotMap {
+    static_assert(N > 0 && N < std::numeric_limits<std::uint32_t>::max(), "bad SlotMap capacity");
+
+    struct Slot {
+        std::uint32_t generation; // текущее поколение ячейки
+        std::uint32_t dense;      // индекс в dense_ для живых, следующий свободный для пустых
+    };
+
+    using storage_t = std::aligned_storage_t<sizeof(T), alignof(T)>;
+    static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+public:
+    using value_type = T;
+    using handle     = PoolHandle;
+    using iterator       = T*;
+    using const_iterator = const T*;
+
+    SlotMap() = default;
+    ~SlotMap() { release_(); }
+
+    SlotMap(const SlotMap&) = delete;
+    SlotMap& operator=(const SlotMap&) = delete;
+
+    SlotMap(SlotMap&& r) noexcept { steal_(r); }
+    SlotMap& operator=(SlotMap&& r) noexcept {
+        if (this != &r) { release_(); steal_(r); }
+        return *this;
+    }
+
+    template <class... Args>
+    PoolHandle emplace(Args&&... args) {
+        ensure_storage_();
+
+        const bool reuse = free_head_ != kNone;
+        if (!reuse && slots_used_ == N) throw std::bad_alloc();
+
+        ::new (static_cast<void*>(&values_[size_])) T(std::forward<Args>(args)...);
+
+        std::uint32_t idx;
+        if (reuse) {
+            idx = free_head_;
+            free_head_ = slots_[idx].dense;
+        } else {
+            idx = slots_used_++;
+            slots_[idx].generation = 1;
+        }
+
+        slots_[idx].dense = size_;
+        dense_to_slot_[size_] = idx;
+        ++size_;
+        return PoolHandle{idx, slots_[idx].generation};
+    }
+
+    PoolHandle insert(const T& v) { return emplace(v); }
+    PoolHandle insert(T&& v)      { return emplace(std::move(v)); }
+
+    // nullptr, если handle устарел
+    T* get(PoolHandle h) noexcept {
+        if (!valid_(h)) return nullptr;
+        return value_at_(slots_[h.index].dense);
+    }
+    const T* get(PoolHandle h) const noexcept { return const_cast<SlotMap*>(this)->get(h); }
+
+    bool contains(PoolHandle h) const noexcept { return valid_(h); }
+
+    // дыра в плотном массиве закрывается последним элементом
+    bool erase(PoolHandle h) noexcept {
+        if (!valid_(h)) return false;
+
+        Slot& s = slots_[h.index];
+        const std::uint32_t hole = s.dense;
+        const std::uint32_t last = size_ - 1;
+        if (hole != last) {
+            *value_at_(hole) = std::move(*value_at_(last));
+            dense_to_slot_[hole] = dense_to_slot_[last];
+            slots_[dense_to_slot_[hole]].dense = hole;
+        }
+        value_at_(last)->~T();
+        --size_;
+
+        if (++s.generation == 0) s.generation = 1;
+        s.dense = free_head_;
+        free_head_ = h.index;
+        return true;
+    }
+
+    void clear() noexcept {
+        for (std::uint32_t i = 0; i < size_; ++i) {
+            std::uint32_t idx = dense_to_slot_[i];
+            value_at_(i)->~T();
+            if (++slots_[idx].generation == 0) slots_[idx].generation = 1;
+            slots_[idx].dense = free_head_;
+            free_head_ = idx;
+        }
+        size_ = 0;
+    }
+
+    // handle элемента по его позиции в плотном массиве (для обхода с удалением)
+    PoolHandle handle_at(std::size_t i) const noexcept {
+        std::uint32_t idx = dense_to_slot_[i];
+        return PoolHandle{idx, slots_[idx].generation};
+    }
+
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t size() const noexcept { return size_; }
+    static constexpr std::size_t capacity() noexcept { return N; }
+
+    T* data() noexcept { return value_at_(0); }
+    const T* data() const noexcept { return const_cast<SlotMap*>(this)->value_at_(0); }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size_; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size_; }
+
+private:
+    bool valid_(PoolHandle h) const noexcept {
+        return h.index < slots_used_ && slots_[h.index].generation == h.generation;
+    }
+
+    T* value_at_(std::uint32_t i) noexcept {
+        return values_ ? std::launder(reinterpret_cast<T*>(&values_[i])) : nullptr;
+    }
+
+    static constexpr std::size_t align_up_(std::size_t n, std::size_t a) noexcept { return (n + a - 1) & ~(a - 1); }
+
+    // смещения массивов в блоке: каждый выровнен под свой тип (storage_t бывает
+    // размером 1..3 байта, Slot и uint32_t требуют 4)
+    static constexpr std::size_t kSlotsOffset = align_up_(sizeof(storage_t) * N, alignof(Slot));
+    static constexpr std::size_t kDenseOffset = align_up_(kSlotsOffset + sizeof(Slot) * N, alignof(std::uint32_t));
+    static constexpr std::size_t kBlockBytes  = kDenseOffset + sizeof(std::uint32_t) * N;
+    static constexpr std::size_t kBlockAlign  = alignof(storage_t) > alignof(Slot) ? alignof(storage_t) : alignof(Slot);
+
+    // все три массива выделяются одним блоком при первой вставке
+    void ensure_storage_() {
+        if (values_) return;
+        void* block = ::operator new(kBlockBytes, std::align_val_t(kBlockAlign));
+        values_        = static_cast<storage_t*>(block);
+        slots_         = reinterpret_cast<Slot*>(static_cast<char*>(block) + kSlotsOffset);
+        dense_to_slot_ = reinterpret_cast<std::uint32_t*>(static_cast<char*>(block) + kDenseOffset);
+    }
+
+    void release_() noexcept {
+        if (!values_) return;
+        for (std::uint32_t i = 0; i < size_; ++i) value_at_(i)->~T();
+        ::operator delete(static_cast<void*>(values_), std::align_val_t(kBlockAlign));
+        values_ = nullptr;
+        slots_ = nullptr;
+        dense_to_slot_ = nullptr;
+        size_ = slots_used_ = 0;
+        free_head_ = kNone;
+    }
+
+    void steal_(SlotMap& r) noexcept {
+        values_        = std::exchange(r.values_, nullptr);
+        slots_         = std::exchange(r.slots_, nullptr);
+        dense_to_slot_ = std::exchange(r.dense_to_slot_, nullptr);
+        size_          = std::exchange(r.size_, 0);
+        slots_used_    = std::exchange(r.slots_used_, 0);
+        free_head_     = std::exchange(r.free_head_, kNone);
+    }
+
+    storage_t*     values_        = nullptr; // плотный массив значений
+    Slot*          slots_         = nullptr; // разреженная таблица handle -> dense
+    std::uint32_t* dense_to_slot_ = nullptr; // обратное отображение dense -> slot
+    std::uint32_t  size_          = 0;
+    std::uint32_t  slots_used_    = 0;       // сколько ячеек slots_ когда-либо выдано
+    std::uint32_t  free_head_     = kNone;   // список свободных ячеек slots_
+};
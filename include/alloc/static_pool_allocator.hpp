@@ -0,0 +1,458 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#include "alloc/pool_profile.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Проверяемый режим пула: контроль принадлежности указателя, двойного
+// освобождения и порча освобождённых ячеек. По умолчанию включён в отладке.
+#ifndef ALLOC_POOL_CHECKED
+#ifdef NDEBUG
+#define ALLOC_POOL_CHECKED 0
+#else
+#define ALLOC_POOL_CHECKED 1
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ALLOC_NOINLINE    __attribute__((noinline))
+#define ALLOC_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#elif defined(_MSC_VER)
+#define ALLOC_NOINLINE    __declspec(noinline)
+#define ALLOC_UNLIKELY(x) (x)
+#else
+#define ALLOC_NOINLINE
+#define ALLOC_UNLIKELY(x) (x)
+#endif
+
+// Бессмертные пулы: слаб никогда не освобождается при завершении процесса
+// (иначе освобождается, только если к моменту выхода в нём нет живых ячеек).
+#ifndef ALLOC_POOL_IMMORTAL
+#define ALLOC_POOL_IMMORTAL 0
+#endif
+
+namespace detail {
+inline std::atomic<bool> pool_fast_exit_flag{false};
+} // namespace detail
+
+// Режим быстрого выхода: после вызова deallocate пулов ничего не делает, а
+// контейнеры с тривиально разрушаемыми элементами не обходят узлы при очистке.
+// Вызывается перед завершением процесса, когда память всё равно вернётся ОС.
+inline void pool_fast_exit() noexcept {
+    detail::pool_fast_exit_flag.store(true, std::memory_order_relaxed);
+}
+
+inline bool pool_fast_exit_enabled() noexcept {
+    return detail::pool_fast_exit_flag.load(std::memory_order_relaxed);
+}
+
+// ручная разметка памяти пула для AddressSanitizer
+#if defined(__SANITIZE_ADDRESS__)
+#define ALLOC_HAS_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ALLOC_HAS_ASAN 1
+#endif
+#endif
+
+#ifdef ALLOC_HAS_ASAN
+#include <sanitizer/asan_interface.h>
+#define ALLOC_ASAN_POISON(p, n)   ASAN_POISON_MEMORY_REGION((p), (n))
+#define ALLOC_ASAN_UNPOISON(p, n) ASAN_UNPOISON_MEMORY_REGION((p), (n))
+#else
+#define ALLOC_ASAN_POISON(p, n)   ((void)(p), (void)(n))
+#define ALLOC_ASAN_UNPOISON(p, n) ((void)(p), (void)(n))
+#endif
+
+// пул-аллокатор на куче
+template <class T, std::size_t N>
+class StaticPoolAllocator {
+public:
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type; // у каждого T свой пул
+
+    template <class U> struct rebind { using other = StaticPoolAllocator<U, N>; };
+
+    StaticPoolAllocator() noexcept = default;
+    template <class U>
+    StaticPoolAllocator(const StaticPoolAllocator<U, N>&) noexcept {}
+
+    pointer allocate(size_type n) {
+        // некоторые реализации STL зовут allocate(0)
+        if (n == 0) return nullptr;
+        if (n != 1) throw std::bad_alloc();
+
+        // горячий путь - только снятие с free-list; инициализация пула и
+        // нарезка новых ячеек живут в холодном refill_()
+        FreeNode* p = state_.free_list;
+        if (ALLOC_UNLIKELY(!p)) p = refill_();
+        ALLOC_ASAN_UNPOISON(p, sizeof(storage_t));
+        state_.free_list = p->next;
+#if ALLOC_POOL_CHECKED
+        check_slot_(p, false, "free list corrupted");
+#endif
+        mark_live_(p);
+        if (++state_.live > state_.peak) state_.peak = state_.live;
+        return reinterpret_cast<pointer>(p);
+    }
+
+    void deallocate(pointer p, size_type) noexcept {
+        // пара к allocate(0); при быстром выходе ячейки не возвращаем
+        if (!p || ALLOC_UNLIKELY(pool_fast_exit_enabled())) return;
+#if ALLOC_POOL_CHECKED
+        check_slot_(p, true, "double free or foreign pointer");
+        std::memset(static_cast<void*>(p), kPoisonByte, sizeof(storage_t));
+#endif
+        // возвращаем ячейку в free-list
+        auto node = reinterpret_cast<FreeNode*>(p);
+        node->next = state_.free_list;
+        state_.free_list = node;
+        mark_free_(p);
+        ALLOC_ASAN_POISON(p, sizeof(storage_t));
+        // Пул опустел после работы больше чем с одной пачкой ячеек - нарезка снова
+        // с начала слаба, и следующий контейнер получает узлы подряд в порядке
+        // выделения, а не в порядке прошлых освобождений. Внутри одной пачки
+        // порядок и так почти последовательный, а частые пары allocate/deallocate
+        // не должны каждый раз уходить в refill_.
+        if (ALLOC_UNLIKELY(--state_.live == 0) && state_.used > kRefillBatch) {
+            state_.free_list = nullptr;
+            state_.used = 0;
+        }
+    }
+
+    // Возврат пачки ячеек (например, от EBR): цепочка собирается локально и
+    // прицепляется к free-list целиком, счётчик live меняется один раз.
+    static void deallocate_bulk(pointer const* ps, size_type n) noexcept {
+        if (n == 0 || ALLOC_UNLIKELY(pool_fast_exit_enabled())) return;
+        FreeNode* head = state_.free_list;
+        for (size_type i = 0; i < n; ++i) {
+            pointer p = ps[i];
+#if ALLOC_POOL_CHECKED
+            check_slot_(p, true, "double free or foreign pointer");
+            std::memset(static_cast<void*>(p), kPoisonByte, sizeof(storage_t));
+#endif
+            auto node = reinterpret_cast<FreeNode*>(p);
+            node->next = head;
+            head = node;
+            mark_free_(p);
+            ALLOC_ASAN_POISON(p, sizeof(storage_t));
+        }
+        state_.free_list = head;
+        state_.live -= n;
+        if (ALLOC_UNLIKELY(state_.live == 0) && state_.used > kRefillBatch) {
+            state_.free_list = nullptr;
+            state_.used = 0;
+        }
+    }
+
+    // Явное выделение слаба заранее (иначе - при первом allocate).
+    // Потокобезопасно; сами allocate/deallocate по-прежнему однопоточные.
+    static void init() { ensure_pool_(); }
+
+    static constexpr size_type capacity() noexcept { return N; }
+    static size_type live_count() noexcept { return state_.live; }
+    // наибольшее число одновременно занятых ячеек; попадает в профиль пулов
+    static size_type peak_count() noexcept { return state_.peak; }
+
+    // номер ячейки слаба, в которой лежит p, и обратно
+    static size_type slot_index(const T* p) noexcept {
+        return static_cast<size_type>(reinterpret_cast<const storage_t*>(p) - state_.pool);
+    }
+    static pointer slot_at(size_type i) noexcept {
+        return reinterpret_cast<pointer>(&state_.pool[i]);
+    }
+    // шаг между соседними ячейками в байтах
+    static constexpr size_type slot_size() noexcept { return sizeof(storage_t); }
+
+    // лежит ли p в слабе этого пула (для смешанных схем "пул + куча")
+    static bool owns(const void* p) noexcept {
+        auto a = reinterpret_cast<std::uintptr_t>(p);
+        auto b = reinterpret_cast<std::uintptr_t>(state_.pool);
+        return state_.pool && a >= b && a < b + sizeof(storage_t) * N;
+    }
+
+    // Обход живых объектов пула в порядке адресов по битовой карте занятости:
+    // последовательное чтение слаба вместо переходов по ссылкам контейнера.
+    // Полностью занятые слова карты обходятся без битовых операций.
+    template <class Fn>
+    static void for_each_live(Fn&& fn) {
+        if (!state_.pool) return;
+        const size_type words = (state_.used + 63) / 64;
+        for (size_type w = 0; w < words; ++w) {
+            std::uint64_t bits = state_.live_bits[w];
+            if (bits == ~std::uint64_t{0}) {
+                for (size_type i = w * 64, e = i + 64; i < e; ++i) fn(*slot_at(i));
+                continue;
+            }
+            while (bits) {
+                fn(*slot_at(w * 64 + ctz64_(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // То же, но кусками: fn(first, n) для каждой серии из n подряд занятых
+    // ячеек (шаг slot_size()). Серии сливаются через границы слов карты, так
+    // что после compact() весь пул - одна серия. Для SIMD-обхода слаба.
+    template <class Fn>
+    static void for_each_live_run(Fn&& fn) {
+        if (!state_.pool) return;
+        const size_type words = (state_.used + 63) / 64;
+        size_type start = 0, len = 0;
+        auto extend = [&](size_type i, size_type n) {
+            if (len && start + len == i) { len += n; return; }
+            if (len) fn(slot_at(start), len);
+            start = i;
+            len = n;
+        };
+        for (size_type w = 0; w < words; ++w) {
+            std::uint64_t bits = state_.live_bits[w];
+            if (bits == ~std::uint64_t{0}) {
+                extend(w * 64, 64);
+                continue;
+            }
+            while (bits) {
+                const unsigned s = ctz64_(bits);
+                const unsigned n = ctz64_(~(bits >> s)); // bits >> s сверху дополнен нулями
+                extend(w * 64 + s, n);
+                bits &= ~(((n == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1)) << s);
+            }
+        }
+        if (len) fn(slot_at(start), len);
+    }
+
+    // Отображение старых адресов перемещённых объектов в новые.
+    // Действительно только внутри fixup-колбэка compact().
+    class Relocation {
+    public:
+        pointer operator()(pointer p) const noexcept {
+            auto a = reinterpret_cast<std::uintptr_t>(p);
+            if (a < first_vacated_ || a >= end_) return p;
+            return *reinterpret_cast<pointer*>(p); // адрес пересылки в освобождённой ячейке
+        }
+        size_type moved() const noexcept { return moved_; }
+
+    private:
+        friend class StaticPoolAllocator;
+        std::uintptr_t first_vacated_ = 0;
+        std::uintptr_t end_           = 0;
+        size_type      moved_         = 0;
+    };
+
+    // Дефрагментация: живые объекты переносятся в начало слаба move-конструированием
+    // (с верхних адресов в дыры на нижних), затем fixup(reloc) должен исправить
+    // все внешние указатели на объекты пула - у каждого контейнера, который его разделяет.
+    // После этого хвост слаба свободен и его можно отдать ОС через trim().
+    template <class Fixup>
+    static size_type compact(Fixup&& fixup) {
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+                      "compact() requires nothrow move construction");
+        Relocation reloc;
+        if (!state_.pool) return 0;
+
+        auto is_free = [](size_type i) { return !((state_.live_bits[i / 64] >> (i % 64)) & 1); };
+
+        size_type lo = 0, hi = state_.used;
+        for (;;) {
+            while (lo < hi && !is_free(lo)) ++lo;
+            while (hi > lo && is_free(hi - 1)) --hi;
+            if (lo >= hi) break;
+            --hi;
+            pointer src = slot_at(hi);
+            pointer dst = slot_at(lo++);
+            ALLOC_ASAN_UNPOISON(dst, sizeof(storage_t));
+            ::new (static_cast<void*>(dst)) T(std::move(*src));
+            src->~T();
+            *reinterpret_cast<pointer*>(src) = dst;
+            mark_live_(dst);
+            mark_free_(src);
+            ++reloc.moved_;
+        }
+
+        reloc.first_vacated_ = reinterpret_cast<std::uintptr_t>(state_.pool + state_.live);
+        reloc.end_           = reinterpret_cast<std::uintptr_t>(state_.pool + state_.used);
+        fixup(static_cast<const Relocation&>(reloc));
+
+        // хвост снова нетронутая часть пула
+#if ALLOC_POOL_CHECKED
+        ALLOC_ASAN_UNPOISON(state_.pool + state_.live, sizeof(storage_t) * (state_.used - state_.live));
+        std::memset(static_cast<void*>(state_.pool + state_.live), kPoisonByte,
+                    sizeof(storage_t) * (state_.used - state_.live));
+#endif
+        ALLOC_ASAN_POISON(state_.pool + state_.live, sizeof(storage_t) * (state_.used - state_.live));
+        state_.used = state_.live;
+        state_.free_list = nullptr;
+        return reloc.moved_;
+    }
+
+    // отдаёт ОС целые страницы нетронутого хвоста слаба; возвращает число байт
+    static size_type trim() noexcept {
+#if defined(__linux__)
+        if (!state_.pool) return 0;
+        const auto page  = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const auto begin = (reinterpret_cast<std::uintptr_t>(state_.pool + state_.used) + page - 1) & ~(page - 1);
+        const auto end   = reinterpret_cast<std::uintptr_t>(state_.pool + N) & ~(page - 1);
+        if (begin >= end) return 0;
+        ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+        return end - begin;
+#else
+        return 0;
+#endif
+    }
+
+    template <class U>
+    bool operator==(const StaticPoolAllocator<U, N>&) const noexcept { return std::is_same_v<T, U>; }
+    template <class U>
+    bool operator!=(const StaticPoolAllocator<U, N>& other) const noexcept { return !(*this == other); }
+
+private:
+    struct FreeNode { FreeNode* next; };
+
+    // ячейка вмещает и T, и ссылку free-list
+    using storage_t = std::aligned_storage_t<
+        (sizeof(T) > sizeof(FreeNode) ? sizeof(T) : sizeof(FreeNode)),
+        (alignof(T) > alignof(FreeNode) ? alignof(T) : alignof(FreeNode))>;
+
+    static constexpr std::size_t kBitmapWords = (N + 63) / 64;
+#if ALLOC_POOL_CHECKED
+    static constexpr unsigned char kPoisonByte = 0xDD;
+#endif
+
+    struct State {
+        storage_t*  pool      = nullptr; // массив N ячеек на куче
+        std::size_t used      = 0;       // сколько ячеек нарезано (выдано или в free-list)
+        std::size_t live      = 0;       // сколько ячеек занято сейчас
+        std::size_t peak      = 0;       // максимум live за время работы
+        FreeNode*   free_list = nullptr; // возвраты поэлементных освобождений
+        std::uint64_t live_bits[kBitmapWords] = {}; // занятость ячеек
+        std::once_flag init_flag;
+        // деструктора нет: состояние доступно и во время статической деструкции,
+        // когда статические контейнеры из других TU ещё возвращают узлы
+    };
+
+    // константная инициализация: состояние валидно (пусто) ещё до любых
+    // динамических конструкторов, так что порядок инициализации TU не важен
+    static inline State state_{};
+
+    // Освобождает слаб при выходе, только если он пуст; иначе слаб "утекает"
+    // до завершения процесса и поздние deallocate остаются корректными.
+    struct Reaper {
+        ~Reaper() {
+            if (ALLOC_POOL_IMMORTAL || !state_.pool || state_.live != 0) return;
+            ::operator delete[](state_.pool, std::align_val_t(alignof(storage_t)));
+            state_.pool = nullptr;
+            state_.used = 0;
+            state_.free_list = nullptr;
+        }
+    };
+    static inline Reaper reaper_{};
+
+    // сколько новых ячеек нарезается в free-list за один refill_
+    static constexpr size_type kRefillBatch = 64;
+
+    static void create_slab_() {
+        state_.pool = static_cast<storage_t*>(
+            ::operator new[](sizeof(storage_t) * N,
+                             std::align_val_t(alignof(storage_t)))
+        );
+        ALLOC_ASAN_POISON(state_.pool, sizeof(storage_t) * N);
+        pool_profile::record(pool_profile::type_name<StaticPoolAllocator>(), &peak_count);
+    }
+
+    static void ensure_pool_() {
+        (void)&reaper_;
+        std::call_once(state_.init_flag, create_slab_);
+        // выделение после Reaper: новый слаб живёт до конца процесса
+        if (ALLOC_UNLIKELY(!state_.pool)) create_slab_();
+    }
+
+    // free-list пуст: нарезаем пачку ячеек из неиспользованной части пула
+    // в порядке адресов, чтобы выдача оставалась последовательной
+    ALLOC_NOINLINE static FreeNode* refill_() {
+        ensure_pool_();
+        if (state_.used == N) throw std::bad_alloc();
+
+        const size_type first = state_.used;
+        const size_type last  = N - first < kRefillBatch ? N : first + kRefillBatch;
+        FreeNode* head = nullptr;
+        for (size_type i = last; i-- > first; ) {
+            auto f = reinterpret_cast<FreeNode*>(&state_.pool[i]);
+            ALLOC_ASAN_UNPOISON(f, sizeof(storage_t));
+            f->next = head;
+            ALLOC_ASAN_POISON(f, sizeof(storage_t));
+            head = f;
+        }
+        state_.used = last;
+        state_.free_list = head;
+        return head;
+    }
+
+    static size_type bit_index_(const void* p) noexcept {
+        return static_cast<size_type>(static_cast<const storage_t*>(p) - state_.pool);
+    }
+    static void mark_live_(const void* p) noexcept {
+        size_type i = bit_index_(p);
+        state_.live_bits[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+    static void mark_free_(const void* p) noexcept {
+        size_type i = bit_index_(p);
+        state_.live_bits[i / 64] &= ~(std::uint64_t{1} << (i % 64));
+    }
+
+    static unsigned ctz64_(std::uint64_t x) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long i;
+        _BitScanForward64(&i, x);
+        return static_cast<unsigned>(i);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+    }
+
+#if ALLOC_POOL_CHECKED
+    [[noreturn]] static void check_failed_(const char* what, const void* p) noexcept {
+        std::fprintf(stderr, "StaticPoolAllocator<%zu-byte T, %zu>: %s (%p)\n",
+                     sizeof(T), N, what, p);
+        std::abort();
+    }
+
+    // проверяет, что p - начало ячейки пула в ожидаемом состоянии
+    static void check_slot_(const void* p, bool expect_live, const char* what) noexcept {
+        auto addr = reinterpret_cast<std::uintptr_t>(p);
+        auto base = reinterpret_cast<std::uintptr_t>(state_.pool);
+        if (!state_.pool || addr < base || addr >= base + sizeof(storage_t) * N
+            || (addr - base) % sizeof(storage_t) != 0)
+            check_failed_("pointer does not belong to the pool", p);
+
+        std::size_t idx = (addr - base) / sizeof(storage_t);
+        bool live = (state_.live_bits[idx / 64] >> (idx % 64)) & 1;
+        if (live != expect_live) check_failed_(what, p);
+    }
+#endif
+};
@@ -0,0 +1,430 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Пул потоков с work-stealing: у каждого рабочего своя дека Chase-Lev,
+// задачи - блоки фиксированного размера из пула того потока, что их создаёт;
+// выполненный блок возвращается в пул-источник, а не в пул исполнителя.
+class TaskScheduler;
+class TaskGroup;
+
+namespace detail {
+
+class TaskPool;
+
+// задача: указатель на функцию + callable в самом блоке (или на куче, если не влез)
+struct Task {
+    static constexpr std::size_t kBlockSize = 128;
+
+    void (*run)(Task*) = nullptr; // выполняет и разрушает callable
+    TaskGroup* group = nullptr;
+    TaskPool*  owner = nullptr;   // пул, из которого взят блок
+
+    static constexpr std::size_t kHeader =
+        (3 * sizeof(void*) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    static constexpr std::size_t kInline = kBlockSize - kHeader;
+    alignas(std::max_align_t) unsigned char storage[kInline];
+};
+
+static_assert(sizeof(Task) == Task::kBlockSize, "Task must fill exactly one block");
+
+// Пул блоков Task: free-list поверх кусков по kChunk блоков, как StaticPoolAllocator,
+// но растущий. get()/put() - только поток-владелец (для inject-пула - под его
+// mutex'ом); остальные потоки возвращают блоки через put_remote() в lock-free
+// стек, который владелец забирает целиком, когда кончается свой free-list.
+// Так блоки не перетекают между пулами и пул не растёт без предела.
+class TaskPool {
+public:
+    static constexpr std::size_t kChunk = 256;
+
+    TaskPool() = default;
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+    ~TaskPool() {
+        for (void* c : chunks_) ::operator delete(c, std::align_val_t(alignof(Task)));
+    }
+
+    Task* get() {
+        if (!free_) free_ = remote_.exchange(nullptr, std::memory_order_acquire);
+        if (!free_) refill_();
+        FreeBlock* b = free_;
+        free_ = b->next;
+        Task* t = ::new (static_cast<void*>(b)) Task;
+        t->owner = this;
+        return t;
+    }
+
+    void put(Task* t) noexcept {
+        t->~Task();
+        auto b = reinterpret_cast<FreeBlock*>(t);
+        b->next = free_;
+        free_ = b;
+    }
+
+    // из любого потока; снимается только целиком (exchange), так что ABA не бывает
+    void put_remote(Task* t) noexcept {
+        t->~Task();
+        auto b = reinterpret_cast<FreeBlock*>(t);
+        b->next = remote_.load(std::memory_order_relaxed);
+        while (!remote_.compare_exchange_weak(b->next, b, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+private:
+    struct FreeBlock { FreeBlock* next; };
+
+    void refill_() {
+        void* chunk = ::operator new(sizeof(Task) * kChunk, std::align_val_t(alignof(Task)));
+        chunks_.push_back(chunk);
+        auto tasks = static_cast<Task*>(chunk);
+        for (std::size_t i = kChunk; i-- > 0; ) {
+            auto b = reinterpret_cast<FreeBlock*>(&tasks[i]);
+            b->next = free_;
+            free_ = b;
+        }
+    }
+
+    FreeBlock*              free_ = nullptr;
+    std::atomic<FreeBlock*> remote_{nullptr};
+    std::vector<void*>      chunks_;
+};
+
+// Дека Chase-Lev (Lê, Pop, Cohen, Zappa Nardelli, PPoPP'13):
+// владелец кладёт и берёт снизу, воры крадут сверху.
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(std::size_t log2_cap = 8) {
+        auto a = new Array(log2_cap);
+        array_.store(a, std::memory_order_relaxed);
+        garbage_.emplace_back(a);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    void push(Task* t) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        Array* a = array_.load(std::memory_order_relaxed);
+        if (b - top > a->mask) a = grow_(a, b, top);
+        a->put(b, t);
+        // release-запись вместо release-барьера: на x86 то же самое, а TSan её понимает
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    Task* take() {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+        Task* t = nullptr;
+        if (top <= b) {
+            t = a->get(b);
+            if (top == b) {
+                if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed))
+                    t = nullptr;
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return t;
+    }
+
+    Task* steal() {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+        if (top >= b) return nullptr;
+        Array* a = array_.load(std::memory_order_acquire);
+        Task* t = a->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+            return nullptr;
+        return t;
+    }
+
+    bool empty() const noexcept {
+        return top_.load(std::memory_order_relaxed) >= bottom_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Array {
+        std::int64_t mask;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+
+        explicit Array(std::size_t log2_cap)
+            : mask((std::int64_t{1} << log2_cap) - 1), slots(new std::atomic<Task*>[std::size_t(mask + 1)]) {}
+
+        Task* get(std::int64_t i) const noexcept { return slots[std::size_t(i & mask)].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, Task* t) noexcept { slots[std::size_t(i & mask)].store(t, std::memory_order_relaxed); }
+    };
+
+    // старые массивы могут ещё читаться ворами - храним их до разрушения деки
+    Array* grow_(Array* a, std::int64_t b, std::int64_t top) {
+        std::size_t log2 = 0;
+        while ((std::int64_t{1} << log2) <= a->mask) ++log2;
+        auto bigger = new Array(log2 + 1);
+        for (std::int64_t i = top; i < b; ++i) bigger->put(i, a->get(i));
+        garbage_.emplace_back(bigger);
+        array_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    std::atomic<Array*> array_{nullptr};
+    std::vector<std::unique_ptr<Array>> garbage_;
+};
+
+} // namespace detail
+
+// Группа задач: run() порождает задачу, wait() дожидается всех, помогая их выполнять.
+// Первое исключение из задач пробрасывается из wait().
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskScheduler& s) noexcept : sched_(s) {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    ~TaskGroup() {
+        try { wait(); } catch (...) {}
+    }
+
+    template <class F>
+    void run(F&& f);
+
+    void wait();
+
+private:
+    friend class TaskScheduler;
+
+    void finish_(std::exception_ptr e) noexcept {
+        if (e) {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (!error_) error_ = std::move(e);
+        }
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    TaskScheduler&           sched_;
+    std::atomic<std::size_t> pending_{0};
+    std::mutex               error_mutex_;
+    std::exception_ptr       error_;
+};
+
+class TaskScheduler {
+public:
+    explicit TaskScheduler(unsigned threads = default_threads()) {
+        if (threads == 0) threads = 1;
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) workers_.push_back(std::make_unique<Worker>());
+        for (unsigned i = 0; i < threads; ++i)
+            workers_[i]->thread = std::thread([this, i] { worker_loop_(i); });
+    }
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    ~TaskScheduler() {
+        stop_.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            sleep_cv_.notify_all();
+        }
+        for (auto& w : workers_) w->thread.join();
+    }
+
+    static unsigned default_threads() noexcept {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    std::size_t thread_count() const noexcept { return workers_.size(); }
+
+    // планировщик по умолчанию на все аппаратные потоки
+    static TaskScheduler& instance() {
+        static TaskScheduler s;
+        return s;
+    }
+
+private:
+    friend class TaskGroup;
+
+    struct Worker {
+        detail::WorkStealingDeque deque;
+        detail::TaskPool          pool;
+        std::thread               thread;
+    };
+
+    // текущий рабочий поток этого планировщика или nullptr
+    Worker* self_() const noexcept {
+        return tls_owner_ == this ? workers_[tls_index_].get() : nullptr;
+    }
+
+    template <class F>
+    void spawn_(TaskGroup& g, F&& f) {
+        using Fn = std::decay_t<F>;
+        Worker* w = self_();
+        detail::Task* t;
+        if (w) {
+            t = w->pool.get();
+        } else {
+            std::lock_guard<std::mutex> lock(inject_mutex_);
+            t = inject_pool_.get();
+        }
+        t->group = &g;
+
+        // конструктор callable (или new) может бросить - блок возвращается в пул
+        try {
+            if constexpr (sizeof(Fn) <= detail::Task::kInline && alignof(Fn) <= alignof(std::max_align_t)) {
+                ::new (static_cast<void*>(t->storage)) Fn(std::forward<F>(f));
+                t->run = [](detail::Task* task) {
+                    auto fn = std::launder(reinterpret_cast<Fn*>(task->storage));
+                    struct Destroy { Fn* p; ~Destroy() { p->~Fn(); } } guard{fn};
+                    (*fn)();
+                };
+            } else {
+                ::new (static_cast<void*>(t->storage)) Fn*(new Fn(std::forward<F>(f)));
+                t->run = [](detail::Task* task) {
+                    std::unique_ptr<Fn> fn(*std::launder(reinterpret_cast<Fn**>(task->storage)));
+                    (*fn)();
+                };
+            }
+        } catch (...) {
+            release_(t);
+            throw;
+        }
+
+        g.pending_.fetch_add(1, std::memory_order_relaxed);
+        queued_.fetch_add(1, std::memory_order_release);
+        if (w) {
+            w->deque.push(t);
+        } else {
+            std::lock_guard<std::mutex> lock(inject_mutex_);
+            inject_.push_back(t);
+        }
+        if (sleepers_.load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            sleep_cv_.notify_one();
+        }
+    }
+
+    void execute_(detail::Task* t) {
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        TaskGroup* g = t->group;
+        std::exception_ptr err;
+        try {
+            t->run(t);
+        } catch (...) {
+            err = std::current_exception();
+        }
+        release_(t);
+        g->finish_(std::move(err));
+    }
+
+    // блок - в пул, из которого он взят: свой - напрямую, чужой - через put_remote
+    void release_(detail::Task* t) noexcept {
+        Worker* w = self_();
+        if (w && t->owner == &w->pool) w->pool.put(t);
+        else t->owner->put_remote(t);
+    }
+
+    // своя дека, затем кража у других рабочих, затем общая очередь
+    detail::Task* find_task_(Worker* w, std::size_t& victim) {
+        if (w) {
+            if (detail::Task* t = w->deque.take()) return t;
+        }
+        const std::size_t n = workers_.size();
+        for (std::size_t k = 0; k < n; ++k) {
+            victim = (victim + 1) % n;
+            if (workers_[victim].get() == w) continue;
+            if (detail::Task* t = workers_[victim]->deque.steal()) return t;
+        }
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        if (inject_.empty()) return nullptr;
+        detail::Task* t = inject_.back();
+        inject_.pop_back();
+        return t;
+    }
+
+    void worker_loop_(unsigned index) {
+        tls_owner_ = this;
+        tls_index_ = index;
+        Worker* w = workers_[index].get();
+        std::size_t victim = index;
+        unsigned idle = 0;
+        while (!stop_.load(std::memory_order_acquire)) {
+            if (detail::Task* t = find_task_(w, victim)) {
+                execute_(t);
+                idle = 0;
+                continue;
+            }
+            if (++idle < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+            sleepers_.fetch_add(1, std::memory_order_acq_rel);
+            {
+                std::unique_lock<std::mutex> lock(sleep_mutex_);
+                if (queued_.load(std::memory_order_acquire) == 0 && !stop_.load(std::memory_order_acquire))
+                    sleep_cv_.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            sleepers_.fetch_sub(1, std::memory_order_acq_rel);
+            idle = 0;
+        }
+        tls_owner_ = nullptr;
+    }
+
+    // ожидающий поток не простаивает, а выполняет задачи (в т.ч. чужих групп)
+    void help_until_(TaskGroup& g) {
+        Worker* w = self_();
+        std::size_t victim = w ? tls_index_ : 0;
+        while (g.pending_.load(std::memory_order_acquire) != 0) {
+            if (detail::Task* t = find_task_(w, victim)) execute_(t);
+            else std::this_thread::yield();
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool>        stop_{false};
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<int>         sleepers_{0};
+    std::mutex               sleep_mutex_;
+    std::condition_variable  sleep_cv_;
+
+    // задачи от потоков вне планировщика
+    std::mutex                 inject_mutex_;
+    std::vector<detail::Task*> inject_;
+    detail::TaskPool           inject_pool_;
+
+    static inline thread_local const TaskScheduler* tls_owner_ = nullptr;
+    static inline thread_local std::size_t          tls_index_ = 0;
+};
+
+template <class F>
+void TaskGroup::run(F&& f) {
+    sched_.spawn_(*this, std::forward<F>(f));
+}
+
+inline void TaskGroup::wait() {
+    sched_.help_until_(*this);
+    std::exception_ptr e;
+    {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        e = std::exchange(error_, nullptr);
+    }
+    if (e) std::rethrow_exception(e);
+}
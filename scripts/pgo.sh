@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+# Цикл PGO: instrument -> train -> use, затем отчёт PGO+LTO против LTO.
+#   scripts/pgo.sh [build-root]
+# Для clang нужен llvm-profdata в PATH.
+set -euo pipefail
+
+SRC_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+ROOT="${1:-${SRC_DIR}/build-pgo}"
+LTO_DIR="${ROOT}/lto"
+PGO_DIR="${ROOT}/pgo"
+PROFILE_DIR="${PGO_DIR}/pgo-profile"
+JOBS="$(nproc 2>/dev/null || echo 2)"
+
+# тренировочная нагрузка: сценарии, под которые оптимизируем
+TRAIN_FILTERS=(map_churn list_build list_iterate)
+
+configure() {
+  cmake -S "${SRC_DIR}" -B "$1" -DCMAKE_BUILD_TYPE=Release -DENABLE_LTO=ON "${@:2}" >/dev/null
+  cmake --build "$1" --parallel "${JOBS}" >/dev/null
+}
+
+echo "== LTO-only build"
+configure "${LTO_DIR}" -DENABLE_PGO=OFF
+
+echo "== instrumented build"
+rm -rf "${PROFILE_DIR}"
+configure "${PGO_DIR}" -DENABLE_PGO=ON -DPGO_PHASE=GENERATE -DPGO_PROFILE_DIR="${PROFILE_DIR}"
+
+echo "== training"
+"${PGO_DIR}/alloc_demo" >/dev/null
+"${PGO_DIR}/alloc_bench" "${TRAIN_FILTERS[@]}" >/dev/null
+
+if ls "${PROFILE_DIR}"/*.profraw >/dev/null 2>&1; then
+  llvm-profdata merge -output="${PROFILE_DIR}/default.profdata" "${PROFILE_DIR}"/*.profraw
+fi
+
+# та же директория сборки: gcc сопоставляет профили по путям объектных файлов
+echo "== optimized build"
+configure "${PGO_DIR}" -DENABLE_PGO=ON -DPGO_PHASE=USE -DPGO_PROFILE_DIR="${PROFILE_DIR}"
+
+echo "== report (Mitems/s, higher is better)"
+"${LTO_DIR}/alloc_bench" "${TRAIN_FILTERS[@]}" > "${ROOT}/lto.txt"
+"${PGO_DIR}/alloc_bench" "${TRAIN_FILTERS[@]}" > "${ROOT}/pgo.txt"
+
+# только строки с результатом: без комментариев и пропущенных случаев
+join <(awk '$1 !~ /^#/ && $4 > 0 {print $1, $4}' "${ROOT}/lto.txt" | sort) \
+     <(awk '$1 !~ /^#/ && $4 > 0 {print $1, $4}' "${ROOT}/pgo.txt" | sort) |
+  awk 'BEGIN { printf "%-40s %12s %12s %8s\n", "case", "LTO", "PGO+LTO", "speedup" }
+       { printf "%-40s %12.2f %12.2f %7.2fx\n", $1, $2, $3, $3 / $2 }' |
+  tee "${ROOT}/report.txt"
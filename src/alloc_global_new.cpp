@@ -0,0 +1,114 @@
+// Замена глобальных operator new/delete на size_class-пулы.
+// Подключается линковкой с alloc::global_new - типы контейнеров не меняются.
+// Блоки до size_class::kMaxSize с обычным выравниванием - из пулов с кэшем
+// потока, остальное и всё сверх ёмкости классов - из malloc.
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h> // _aligned_malloc / _aligned_free
+#endif
+
+#include "alloc/size_class_pool.hpp"
+
+namespace {
+
+constexpr std::size_t kPoolAlign = alignof(std::max_align_t);
+
+void* heap_allocate(std::size_t n, std::size_t align) {
+    for (;;) {
+        void* p = nullptr;
+        if (align <= kPoolAlign) {
+            p = std::malloc(n ? n : 1);
+        } else {
+#if defined(_MSC_VER)
+            // в CRT MSVC нет aligned_alloc; такой блок освобождается только _aligned_free
+            p = _aligned_malloc(n ? n : 1, align);
+#else
+            // aligned_alloc требует размер, кратный выравниванию
+            p = std::aligned_alloc(align, (n + align - 1) & ~(align - 1));
+#endif
+        }
+        if (p) return p;
+        std::new_handler h = std::get_new_handler();
+        if (!h) throw std::bad_alloc();
+        h();
+    }
+}
+
+// блок из heap_allocate с выравниванием больше обычного
+inline void heap_deallocate_aligned(void* p) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+inline void* allocate(std::size_t n, std::size_t align = kPoolAlign) {
+    if (align <= kPoolAlign) {
+        if (void* p = size_class::allocate(n)) return p;
+    }
+    return heap_allocate(n, align);
+}
+
+inline void* allocate_nothrow(std::size_t n, std::size_t align = kPoolAlign) noexcept {
+    try {
+        return allocate(n, align);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+inline void deallocate(void* p) noexcept {
+    if (!p) return;
+    if (!size_class::deallocate(p)) std::free(p);
+}
+
+// размер известен - класс берётся из него, без поиска по адресу
+inline void deallocate(void* p, std::size_t n) noexcept {
+    if (!p) return;
+    if (!size_class::deallocate(p, n)) std::free(p);
+}
+
+// выровненный блок лежит в пуле, только если выравнивание не больше обычного
+inline void deallocate(void* p, std::align_val_t a) noexcept {
+    if (std::size_t(a) <= kPoolAlign) return deallocate(p);
+    if (p) heap_deallocate_aligned(p);
+}
+
+inline void deallocate(void* p, std::size_t n, std::align_val_t a) noexcept {
+    if (std::size_t(a) <= kPoolAlign) return deallocate(p, n);
+    if (p) heap_deallocate_aligned(p);
+}
+
+} // namespace
+
+void* operator new(std::size_t n) { return allocate(n); }
+void* operator new[](std::size_t n) { return allocate(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return allocate_nothrow(n); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return allocate_nothrow(n); }
+
+void* operator new(std::size_t n, std::align_val_t a) { return allocate(n, std::size_t(a)); }
+void* operator new[](std::size_t n, std::align_val_t a) { return allocate(n, std::size_t(a)); }
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(n, std::size_t(a));
+}
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(n, std::size_t(a));
+}
+
+void operator delete(void* p) noexcept { deallocate(p); }
+void operator delete[](void* p) noexcept { deallocate(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { deallocate(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { deallocate(p); }
+void operator delete(void* p, std::size_t n) noexcept { deallocate(p, n); }
+void operator delete[](void* p, std::size_t n) noexcept { deallocate(p, n); }
+
+void operator delete(void* p, std::align_val_t a) noexcept { deallocate(p, a); }
+void operator delete[](void* p, std::align_val_t a) noexcept { deallocate(p, a); }
+void operator delete(void* p, std::align_val_t a, const std::nothrow_t&) noexcept { deallocate(p, a); }
+void operator delete[](void* p, std::align_val_t a, const std::nothrow_t&) noexcept { deallocate(p, a); }
+void operator delete(void* p, std::size_t n, std::align_val_t a) noexcept { deallocate(p, n, a); }
+void operator delete[](void* p, std::size_t n, std::align_val_t a) noexcept { deallocate(p, n, a); }
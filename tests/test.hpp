@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// минимальный каркас тестов: регистрация кейсов и CHECK, не зависящий от NDEBUG
+namespace test {
+
+using CaseFn = void (*)();
+
+struct Case {
+    std::string name;
+    CaseFn      fn;
+};
+
+inline std::vector<Case>& registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+// провалы текущего кейса; CHECK можно звать из рабочих потоков
+inline std::atomic<int>& failures() {
+    static std::atomic<int> n{0};
+    return n;
+}
+
+struct Registrar {
+    Registrar(const char* name, CaseFn fn) { registry().push_back({name, fn}); }
+};
+
+inline void fail(const char* expr, const char* file, int line) {
+    std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expr);
+    ++failures();
+}
+
+} // namespace test
+
+#define TEST_CONCAT_(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_(a, b)
+#define TEST_CASE(name, fn) static const test::Registrar TEST_CONCAT(test_reg_, __LINE__)(name, fn)
+
+#define CHECK(expr) ((expr) ? (void)0 : test::fail(#expr, __FILE__, __LINE__))
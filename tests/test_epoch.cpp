@@ -0,0 +1,100 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "alloc/adaptive_pool_allocator.hpp"
+#include "alloc/epoch.hpp"
+#include "alloc/static_pool_allocator.hpp"
+#include "test.hpp"
+
+namespace {
+
+struct Cell {
+    long               value;
+    std::atomic<Cell*> next{nullptr};
+    ~Cell() { value = -1; }
+};
+
+template <class Alloc>
+Cell* make_cell(long v) {
+    std::lock_guard<std::mutex> lock(ebr::pool_mutex<Alloc>());
+    Alloc a;
+    return ::new (static_cast<void*>(a.allocate(1))) Cell{v};
+}
+
+// Писатели подменяют указатель и отдают старую ячейку в EBR; читатели под
+// Guard разыменовывают текущую - она не должна быть разрушена.
+void ebr_swap() {
+    using Alloc = StaticPoolAllocator<Cell, 1 << 16>;
+    std::atomic<Cell*> head{make_cell<Alloc>(0)};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> ts;
+    for (int r = 0; r < 2; ++r) {
+        ts.emplace_back([&] {
+            while (!stop.load()) {
+                ebr::Guard g;
+                CHECK(head.load(std::memory_order_acquire)->value >= 0);
+            }
+        });
+    }
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < 20000; ++i)
+                ebr::retire_to_pool<Alloc>(head.exchange(make_cell<Alloc>(i + 1), std::memory_order_acq_rel));
+            ebr::drain();
+        });
+    }
+    for (auto& w : writers) w.join();
+    stop.store(true);
+    for (auto& t : ts) t.join();
+    ebr::retire_to_pool<Alloc>(head.exchange(nullptr));
+    ebr::drain();
+    CHECK(Alloc::live_count() == 0);
+}
+
+using HpAlloc = AdaptivePoolAllocator<Cell>;
+std::atomic<long> g_hp_freed{0};
+
+void free_cells(void*, void* const* ps, std::size_t n) noexcept {
+    std::lock_guard<std::mutex> lock(ebr::pool_mutex<HpAlloc>());
+    for (std::size_t i = 0; i < n; ++i) static_cast<Cell*>(ps[i])->~Cell();
+    HpAlloc::deallocate_bulk(reinterpret_cast<Cell* const*>(ps), n);
+    g_hp_freed += static_cast<long>(n);
+}
+
+// то же на указателях опасности
+void hazard_swap() {
+    std::atomic<Cell*> head{make_cell<HpAlloc>(0)};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> ts;
+    for (int r = 0; r < 2; ++r) {
+        ts.emplace_back([&] {
+            hp::Hazard hz;
+            while (!stop.load()) {
+                CHECK(hz.protect(head)->value >= 0);
+                hz.reset();
+            }
+        });
+    }
+    constexpr int kSwaps = 10000;
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < kSwaps; ++i) hp::retire(head.exchange(make_cell<HpAlloc>(i + 1)), &free_cells);
+            hp::scan();
+        });
+    }
+    for (auto& w : writers) w.join();
+    stop.store(true);
+    for (auto& t : ts) t.join();
+    hp::retire(head.exchange(nullptr), &free_cells);
+    hp::scan();
+    CHECK(g_hp_freed.load() == 2 * kSwaps + 1);
+}
+
+TEST_CASE("epoch/ebr_swap", ebr_swap);
+TEST_CASE("epoch/hazard_swap", hazard_swap);
+
+} // namespace
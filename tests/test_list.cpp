@@ -0,0 +1,79 @@
+#include <vector>
+
+#include "alloc/simple_forward_list.hpp"
+#include "alloc/static_pool_allocator.hpp"
+#include "test.hpp"
+
+namespace {
+
+template <class List>
+std::vector<int> items(List& l) {
+    return std::vector<int>(l.begin(), l.end());
+}
+
+// split() и nth() с индексом и без него дают одни и те же границы
+void index_split() {
+    for (int indexed = 0; indexed < 2; ++indexed) {
+        for (std::size_t n : {0, 1, 5, 100, 1001}) {
+            SimpleForwardList<int> l;
+            std::vector<int> model;
+            for (std::size_t i = 0; i < n + 50; ++i) {
+                l.push_back(int(i));
+                model.push_back(int(i));
+            }
+            for (int i = 0; i < 50; ++i) l.pop_front();
+            model.erase(model.begin(), model.begin() + 50);
+            if (indexed) l.build_index(3);
+            CHECK(items(l) == model);
+            for (std::size_t k = 0; k < n; k += 7) CHECK(l.nth(k) == model[k]);
+
+            for (std::size_t parts : {1, 3, 8, 200}) {
+                auto b = l.split(parts);
+                CHECK(b.size() == parts + 1);
+                CHECK(b.back() == l.end());
+                for (std::size_t i = 0; i < parts; ++i) {
+                    const std::size_t k = n * i / parts;
+                    CHECK(b[i] == l.iter_at(k));
+                    if (k < n) CHECK(*b[i] == model[k]);
+                }
+            }
+        }
+    }
+}
+
+// Два списка на одном пуле: compact() одного не должен двигать узлы другого.
+void compact_shared_pool() {
+    using List = SimpleForwardList<int, StaticPoolAllocator<int, 256>>;
+    using NodeAlloc = List::node_allocator_type;
+    List a, b;
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(i);
+        b.push_back(1000 + i);
+    }
+    for (int i = 0; i < 90; ++i) a.pop_front();
+    const std::vector<int> a_items = items(a), b_items = items(b);
+
+    CHECK(!a.compact());
+    CHECK(items(a) == a_items);
+    CHECK(items(b) == b_items);
+
+    // разделяемый пул сжимается через аллокатор, fixup - для каждого списка
+    NodeAlloc::compact([&](const auto& reloc) {
+        a.relink(reloc);
+        b.relink(reloc);
+    });
+    CHECK(NodeAlloc::live_count() == a.size() + b.size());
+    CHECK(items(a) == a_items);
+    CHECK(items(b) == b_items);
+
+    b.clear();
+    CHECK(a.compact());
+    CHECK(items(a) == a_items);
+    a.push_back(7);
+    CHECK(a.size() == a_items.size() + 1);
+}
+
+TEST_CASE("list/index_split", index_split);
+TEST_CASE("list/compact_shared_pool", compact_shared_pool);
+
+} // namespace
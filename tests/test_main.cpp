@@ -0,0 +1,25 @@
+#include <cstdio>
+#include <string>
+
+#include "test.hpp"
+
+// использование: alloc_tests [фильтр...] - кейсы, в имени которых есть подстрока
+int main(int argc, char** argv) {
+    int failed = 0, run = 0;
+    for (const auto& c : test::registry()) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i)
+            if (c.name.find(argv[i]) != std::string::npos) selected = true;
+        if (!selected) continue;
+
+        test::failures() = 0;
+        c.fn();
+        ++run;
+        const bool ok = test::failures() == 0;
+        if (!ok) ++failed;
+        std::printf("%-40s %s\n", c.name.c_str(), ok ? "ok" : "FAILED");
+        std::fflush(stdout);
+    }
+    std::printf("%d/%d passed\n", run - failed, run);
+    return failed == 0 && run > 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#include <cstdint>
+#include <map>
+#include <random>
+
+#include "alloc/radix_tree.hpp"
+#include "test.hpp"
+
+namespace {
+
+// случайные insert/erase/find против std::map; диапазон ключей задаёт плотность
+template <class K>
+void run_against_map(unsigned seed, long long range) {
+    RadixTreeMap<K, long> t;
+    std::map<K, long> m;
+    std::mt19937_64 g(seed);
+    for (int i = 0; i < 50000; ++i) {
+        const K k = static_cast<K>(range ? static_cast<long long>(g() % range) - range / 2
+                                         : static_cast<long long>(g()));
+        switch (g() % 4) {
+        case 0:
+        case 1:
+            CHECK(t.insert(k, i) == m.emplace(k, i).second);
+            break;
+        case 2:
+            CHECK(t.erase(k) == (m.erase(k) == 1));
+            break;
+        default: {
+            const long* v = t.find(k);
+            auto it = m.find(k);
+            CHECK((v != nullptr) == (it != m.end()));
+            if (v && it != m.end()) CHECK(*v == it->second);
+        }
+        }
+    }
+    CHECK(t.size() == m.size());
+    // обход - по возрастанию ключей
+    auto it = m.begin();
+    bool same = true;
+    t.for_each([&](K k, const long& v) {
+        same = same && it != m.end() && it->first == k && it->second == v;
+        if (it != m.end()) ++it;
+    });
+    CHECK(same && it == m.end());
+    for (const auto& kv : m) CHECK(t.erase(kv.first));
+    CHECK(t.empty());
+}
+
+void against_map() {
+    run_against_map<int>(1, 5000);
+    run_against_map<int>(2, 0);
+    run_against_map<long long>(3, 1 << 20);
+    run_against_map<std::uint64_t>(4, 0);
+    run_against_map<std::uint8_t>(5, 256);
+}
+
+TEST_CASE("radix_tree/against_map", against_map);
+
+} // namespace
@@ -0,0 +1,52 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alloc/epoch.hpp"
+#include "alloc/rcu_forward_list.hpp"
+#include "alloc/static_pool_allocator.hpp"
+#include "test.hpp"
+
+namespace {
+
+// Писатель меняет список, читатели обходят его без блокировок: порядок
+// значений должен сохраняться, а узлы - не освобождаться под читателем.
+void readers_during_writes() {
+    // ёмкость с запасом: до ebr::kMaxGarbage узлов на поток ждут освобождения
+    using Alloc = StaticPoolAllocator<std::string, 1 << 17>;
+    {
+        RcuForwardList<std::string, Alloc> l;
+        for (int i = 0; i < 100; ++i) l.push_back(std::to_string(i));
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 2; ++t) {
+            readers.emplace_back([&] {
+                while (!stop.load()) {
+                    long prev = -1;
+                    for (const std::string& s : l.read()) {
+                        const long v = std::stol(s);
+                        CHECK(v > prev);
+                        prev = v;
+                    }
+                }
+            });
+        }
+        for (int i = 100; i < 20000; ++i) {
+            l.push_back(std::to_string(i));
+            if (i % 3 == 0) l.pop_front();
+            if (i % 500 == 0) l.remove_if([](const std::string& s) { return std::stol(s) % 2 == 0; });
+        }
+        stop.store(true);
+        for (auto& r : readers) r.join();
+
+        std::size_t n = 0;
+        l.for_each([&](const std::string&) { ++n; });
+        CHECK(n == l.size());
+    }
+    ebr::drain();
+}
+
+TEST_CASE("rcu_list/readers_during_writes", readers_during_writes);
+
+} // namespace
@@ -0,0 +1,107 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "alloc/concurrent_skip_list.hpp"
+#include "alloc/epoch.hpp"
+#include "test.hpp"
+
+namespace {
+
+constexpr int kWriters = 3;
+
+inline std::uint32_t xorshift(std::uint32_t& x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// У каждого писателя свои ключи (сверяются с моделью) и общие (гонки вставки и
+// удаления одного ключа); читатель обходит диапазон во время записи.
+void writers_and_reader() {
+    constexpr int kKeys = 1000;
+    ConcurrentSkipList l;
+    std::vector<std::set<int>> model(kWriters);
+    std::atomic<bool> stop{false};
+
+    std::thread reader([&] {
+        while (!stop.load()) {
+            int prev = -1;
+            l.for_each_in_range(0, 2 * kKeys, [&](int k, int v) {
+                CHECK(k > prev && v == k);
+                prev = k;
+            });
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kWriters; ++t) {
+        writers.emplace_back([&, t] {
+            std::uint32_t x = 12345u + static_cast<std::uint32_t>(t);
+            for (int i = 0; i < 20000; ++i) {
+                const int k = static_cast<int>(xorshift(x) % kKeys);
+                if (k % kWriters != t) {
+                    if (x & 1024) l.insert(k + kKeys, k + kKeys);
+                    else l.erase(k + kKeys);
+                    continue;
+                }
+                if (x & 1) {
+                    CHECK(l.insert(k, k) == (model[t].count(k) == 0));
+                    model[t].insert(k);
+                } else {
+                    CHECK(l.erase(k) == (model[t].count(k) == 1));
+                    model[t].erase(k);
+                }
+                CHECK(l.contains(k) == (model[t].count(k) == 1));
+            }
+        });
+    }
+    for (auto& w : writers) w.join();
+    stop.store(true);
+    reader.join();
+
+    std::set<int> all;
+    for (const auto& m : model) all.insert(m.begin(), m.end());
+    std::vector<int> got;
+    l.for_each_in_range(0, kKeys, [&](int k, int) { got.push_back(k); });
+    CHECK(got == std::vector<int>(all.begin(), all.end()));
+}
+
+// Читатель застрял в Guard: мусор писателя (erase под своим Guard) не должен
+// превысить ebr::kMaxGarbage - писатель ждёт, пока читатель не выйдет.
+void garbage_bounded_by_stalled_reader() {
+    ConcurrentSkipList l;
+    std::atomic<std::size_t> pending{0};
+    std::atomic<bool> pinned{false}, done{false};
+    std::size_t max_pending = 0;
+
+    std::thread reader([&] {
+        ebr::Guard g;
+        pinned.store(true);
+        // держим эпоху, пока писатель не подойдёт к пределу, и ещё немного
+        while (!done.load() && pending.load() < ebr::kMaxGarbage - 2 * ebr::kBagSize) std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+    while (!pinned.load()) std::this_thread::yield();
+
+    for (int i = 0; i < int(ebr::kMaxGarbage) + 4 * int(ebr::kBagSize); ++i) {
+        l.insert(i, i);
+        l.erase(i);
+        const std::size_t p = ebr::pending();
+        pending.store(p);
+        if (p > max_pending) max_pending = p;
+    }
+    done.store(true);
+    reader.join();
+    CHECK(max_pending <= ebr::kMaxGarbage);
+    ebr::drain();
+    CHECK(ebr::pending() == 0);
+}
+
+TEST_CASE("skip_list/writers_and_reader", writers_and_reader);
+TEST_CASE("skip_list/garbage_bounded_by_stalled_reader", garbage_bounded_by_stalled_reader);
+
+} // namespace
@@ -0,0 +1,50 @@
+#include <vector>
+
+#include "alloc/slot_map.hpp"
+#include "test.hpp"
+
+namespace {
+
+// значения размером 1 и 3 байта: таблица ячеек за ними должна быть выровнена
+struct Odd {
+    char c[3];
+};
+
+void odd_sizes() {
+    SlotMap<char, 3> m;
+    const PoolHandle x = m.insert('x'), y = m.insert('y'), z = m.insert('z');
+    CHECK(m.erase(y));
+    CHECK(!m.get(y) && !m.contains(y));
+    const PoolHandle w = m.insert('w');
+    CHECK(w.index == y.index && w.generation != y.generation);
+    CHECK(*m.get(x) == 'x' && *m.get(z) == 'z' && *m.get(w) == 'w');
+
+    SlotMap<Odd, 5> o;
+    std::vector<PoolHandle> hs;
+    for (char i = 0; i < 5; ++i) hs.push_back(o.insert(Odd{{i, char(i + 1), char(i + 2)}}));
+    CHECK(o.erase(hs[1]) && o.erase(hs[3]));
+    CHECK(o.size() == 3);
+    for (std::size_t i : {0, 2, 4}) CHECK(o.get(hs[i])->c[2] == char(i + 2));
+    int n = 0;
+    for (const Odd& v : o) n += v.c[0];
+    CHECK(n == 0 + 2 + 4);
+}
+
+// устаревший handle не резолвится и после многих циклов erase/insert
+void stale_handles() {
+    SlotMap<int, 4> m;
+    PoolHandle h = m.insert(0);
+    for (int i = 1; i < 100; ++i) {
+        CHECK(m.erase(h));
+        CHECK(!m.erase(h));
+        const PoolHandle next = m.insert(i);
+        CHECK(!m.contains(h) && *m.get(next) == i);
+        h = next;
+    }
+    CHECK(m.size() == 1);
+}
+
+TEST_CASE("slot_map/odd_sizes", odd_sizes);
+TEST_CASE("slot_map/stale_handles", stale_handles);
+
+} // namespace
@@ -0,0 +1,112 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "alloc/parallel.hpp"
+#include "alloc/simple_forward_list.hpp"
+#include "alloc/static_pool_allocator.hpp"
+#include "alloc/task_scheduler.hpp"
+#include "test.hpp"
+
+namespace {
+
+// Задачи кладутся в деки Chase-Lev своих потоков и крадутся соседями;
+// вложенные группы проверяют take/steal на одной деке одновременно.
+void nested_groups() {
+    TaskScheduler s(3);
+    std::atomic<int> count{0};
+    TaskGroup g(s);
+    for (int i = 0; i < 64; ++i) {
+        g.run([&] {
+            TaskGroup h(s);
+            for (int j = 0; j < 64; ++j) h.run([&] { count.fetch_add(1, std::memory_order_relaxed); });
+            h.wait();
+        });
+    }
+    g.wait();
+    CHECK(count.load() == 64 * 64);
+}
+
+// Задачи от потоков вне планировщика берут блоки из inject-пула, а выполняют
+// их рабочие: блоки возвращаются в пул-источник через put_remote.
+void external_rounds() {
+    TaskScheduler s(3);
+    std::atomic<long> count{0};
+    std::vector<std::thread> clients;
+    for (int c = 0; c < 2; ++c) {
+        clients.emplace_back([&] {
+            for (int r = 0; r < 20; ++r) {
+                TaskGroup g(s);
+                for (int i = 0; i < 500; ++i) g.run([&] { count.fetch_add(1, std::memory_order_relaxed); });
+                g.wait();
+            }
+        });
+    }
+    for (auto& c : clients) c.join();
+    CHECK(count.load() == 2L * 20 * 500);
+}
+
+void exception_propagates() {
+    TaskScheduler s(2);
+    bool caught = false;
+    try {
+        TaskGroup g(s);
+        for (int i = 0; i < 100; ++i)
+            g.run([i] { if (i == 50) throw std::runtime_error("task"); });
+        g.wait();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    CHECK(caught);
+}
+
+// копирование callable бросает: run() пробрасывает исключение, группа не ждёт
+// несуществующую задачу, а планировщик продолжает работать
+struct ThrowingCopy {
+    std::atomic<int>* count;
+    explicit ThrowingCopy(std::atomic<int>* c) : count(c) {}
+    ThrowingCopy(const ThrowingCopy&) { throw std::runtime_error("copy"); }
+    void operator()() const { count->fetch_add(1); }
+};
+
+void spawn_throws() {
+    TaskScheduler s(2);
+    std::atomic<int> count{0};
+    const ThrowingCopy bad(&count);
+    TaskGroup g(s);
+    for (int i = 0; i < 1000; ++i) {
+        bool caught = false;
+        try {
+            g.run(bad);
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        CHECK(caught);
+        g.run([&] { count.fetch_add(1); });
+    }
+    g.wait();
+    CHECK(count.load() == 1000);
+}
+
+// список с индексом делится на куски, без индекса - обходится последовательно
+void list_for_each() {
+    TaskScheduler s(3);
+    for (int indexed = 0; indexed < 2; ++indexed) {
+        SimpleForwardList<int, StaticPoolAllocator<int, 20000>> l;
+        for (int i = 0; i < 10000; ++i) l.push_back(i);
+        if (indexed) l.build_index(5);
+        parallel::parallel_for_each(l, [](int& x) { x *= 2; }, 64, s);
+        long sum = 0;
+        for (int x : l) sum += x;
+        CHECK(sum == 10000L * 9999);
+    }
+}
+
+TEST_CASE("task_scheduler/nested_groups", nested_groups);
+TEST_CASE("task_scheduler/external_rounds", external_rounds);
+TEST_CASE("task_scheduler/exception_propagates", exception_propagates);
+TEST_CASE("task_scheduler/spawn_throws", spawn_throws);
+TEST_CASE("task_scheduler/list_for_each", list_for_each);
+
+} // namespace